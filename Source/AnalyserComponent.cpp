@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    AnalyserComponent.cpp
+    Created: 19 Oct 2026 11:40:32am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "AnalyserComponent.h"
+
+namespace
+{
+    constexpr float minDecibels = -90.0f;
+    constexpr float spectrumFallDecibels = 1.5f;
+    constexpr float minFrequency = 20.0f;
+}
+
+AnalyserComponent::AnalyserComponent(SynthAudioProcessor& p)
+    : audioProcessor(p)
+{
+    spectrumLevels.fill(minDecibels);
+    setOpaque(true);
+}
+
+AnalyserComponent::~AnalyserComponent()
+{
+    setAnalysing(false);
+}
+
+void AnalyserComponent::visibilityChanged()
+{
+    setAnalysing(isVisible());
+}
+
+void AnalyserComponent::setAnalysing(bool shouldAnalyse)
+{
+    // El hilo de audio solo empuja muestras mientras hay alguien leyendolas
+    audioProcessor.setAnalyserActive(shouldAnalyse);
+
+    if (shouldAnalyse)
+        startTimerHz(frameRateHz);
+    else
+        stopTimer();
+}
+
+void AnalyserComponent::timerCallback()
+{
+    auto& fifo = audioProcessor.getAnalyserFifo();
+    bool hasNewSamples = false;
+
+    for (int numPulled; (numPulled = fifo.pull(pullBuffer.data(), (int)pullBuffer.size())) > 0;)
+    {
+        for (int i = 0; i < numPulled; ++i)
+        {
+            history[(size_t)historyPosition] = pullBuffer[(size_t)i];
+            historyPosition = (historyPosition + 1) & (fftSize - 1);
+        }
+
+        hasNewSamples = true;
+    }
+
+    if (! hasNewSamples)
+        return;
+
+    updateScopePath();
+    updateSpectrumPath();
+    repaint();
+}
+
+void AnalyserComponent::updateScopePath()
+{
+    // Buscar un cruce por cero ascendente para que la forma de onda no baile
+    const int searchStart = historyPosition - 2 * scopeSize;
+    int start = historyPosition - scopeSize;
+
+    for (int i = searchStart; i < historyPosition - scopeSize; ++i)
+    {
+        const auto previous = history[(size_t)(i & (fftSize - 1))];
+        const auto current = history[(size_t)((i + 1) & (fftSize - 1))];
+
+        if (previous < 0.0f && current >= 0.0f)
+        {
+            start = i + 1;
+            break;
+        }
+    }
+
+    scopePath.clear();
+
+    for (int i = 0; i < scopeSize; ++i)
+    {
+        const auto sample = juce::jlimit(-1.0f, 1.0f, history[(size_t)((start + i) & (fftSize - 1))]);
+        const auto x = juce::jmap((float)i, 0.0f, (float)(scopeSize - 1), scopeArea.getX(), scopeArea.getRight());
+        const auto y = juce::jmap(sample, -1.0f, 1.0f, scopeArea.getBottom(), scopeArea.getY());
+
+        if (i == 0)
+            scopePath.startNewSubPath(x, y);
+        else
+            scopePath.lineTo(x, y);
+    }
+}
+
+void AnalyserComponent::updateSpectrumPath()
+{
+    for (int i = 0; i < fftSize; ++i)
+        fftData[(size_t)i] = history[(size_t)((historyPosition + i) & (fftSize - 1))];
+
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    juce::FloatVectorOperations::multiply(fftData.data(), sharedResources->getHannWindow(), fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    const auto nyquist = (float)audioProcessor.getAnalyserSampleRate() * 0.5f;
+    const auto maxFrequency = juce::jmax(minFrequency * 2.0f, nyquist);
+
+    spectrumPath.clear();
+
+    for (int i = 0; i < spectrumPoints; ++i)
+    {
+        const auto proportion = (float)i / (float)(spectrumPoints - 1);
+        const auto frequency = minFrequency * std::pow(maxFrequency / minFrequency, proportion);
+        const auto bin = juce::jlimit(0, fftSize / 2 - 1, (int)(frequency / nyquist * (float)(fftSize / 2)));
+
+        // Un seno de amplitud 1 con ventana Hann da un pico de fftSize / 4
+        const auto level = juce::Decibels::gainToDecibels(fftData[(size_t)bin] * 4.0f / (float)fftSize, minDecibels);
+        auto& smoothed = spectrumLevels[(size_t)i];
+        smoothed = juce::jmax(level, smoothed - spectrumFallDecibels);
+
+        const auto x = spectrumArea.getX() + proportion * spectrumArea.getWidth();
+        const auto y = juce::jmap(smoothed, minDecibels, 0.0f, spectrumArea.getBottom(), spectrumArea.getY());
+
+        if (i == 0)
+            spectrumPath.startNewSubPath(x, y);
+        else
+            spectrumPath.lineTo(x, y);
+    }
+}
+
+void AnalyserComponent::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    g.setColour(juce::Colours::darkgrey);
+    g.drawRect(scopeArea);
+    g.drawRect(spectrumArea);
+
+    g.setColour(juce::Colours::limegreen);
+    g.strokePath(scopePath, juce::PathStrokeType(1.5f));
+    g.strokePath(spectrumPath, juce::PathStrokeType(1.5f));
+}
+
+void AnalyserComponent::resized()
+{
+    auto area = getLocalBounds().toFloat().reduced(4.0f);
+    scopeArea = area.removeFromLeft(area.getWidth() * 0.5f).reduced(4.0f, 0.0f);
+    spectrumArea = area.reduced(4.0f, 0.0f);
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+	AnalyserComponent.h
+	Created: 19 Oct 2026 11:40:32am
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "SharedDspResources.h"
+
+// Osciloscopio y espectro. Todo el analisis se hace en el timer del hilo de
+// mensajes y solo mientras el componente esta visible.
+class AnalyserComponent : public juce::Component, private juce::Timer {
+
+public:
+	AnalyserComponent(SynthAudioProcessor&);
+	~AnalyserComponent() override;
+
+	void paint(juce::Graphics&) override;
+	void resized() override;
+	void visibilityChanged() override;
+
+private:
+	void timerCallback() override;
+	void setAnalysing(bool shouldAnalyse);
+	void updateScopePath();
+	void updateSpectrumPath();
+
+	static constexpr int frameRateHz = 30;
+	static constexpr int fftOrder = 11;
+	static constexpr int fftSize = 1 << fftOrder;
+	static constexpr int scopeSize = 512;
+	static constexpr int spectrumPoints = 256;
+
+	SynthAudioProcessor& audioProcessor;
+
+	juce::dsp::FFT fft{ fftOrder };
+	juce::SharedResourcePointer<SharedDspResources> sharedResources;
+	static_assert(fftSize == SharedDspResources::windowSize, "La ventana compartida debe tener el tamano de la FFT");
+
+	std::array<float, fftSize> history{};
+	int historyPosition = 0;
+	std::array<float, 2 * fftSize> fftData{};
+	std::array<float, spectrumPoints> spectrumLevels{};
+	std::array<float, 1024> pullBuffer{};
+
+	juce::Path scopePath, spectrumPath;
+	juce::Rectangle<float> scopeArea, spectrumArea;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyserComponent)
+};
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+	AnalyserFifo.h
+	Created: 19 Oct 2026 11:40:32am
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Cola de un productor (hilo de audio) y un consumidor (editor) sin bloqueos.
+// Si el editor no consume a tiempo se descartan las muestras nuevas.
+class AnalyserFifo {
+
+public:
+	static constexpr int capacity = 1 << 14;
+
+	void push(const float* data, int numSamples) noexcept
+	{
+		const auto scope = fifo.write(numSamples);
+
+		if (scope.blockSize1 > 0)
+			juce::FloatVectorOperations::copy(buffer.data() + scope.startIndex1, data, scope.blockSize1);
+		if (scope.blockSize2 > 0)
+			juce::FloatVectorOperations::copy(buffer.data() + scope.startIndex2, data + scope.blockSize1, scope.blockSize2);
+	}
+
+	int pull(float* dest, int maxSamples) noexcept
+	{
+		const auto scope = fifo.read(maxSamples);
+
+		if (scope.blockSize1 > 0)
+			juce::FloatVectorOperations::copy(dest, buffer.data() + scope.startIndex1, scope.blockSize1);
+		if (scope.blockSize2 > 0)
+			juce::FloatVectorOperations::copy(dest + scope.blockSize1, buffer.data() + scope.startIndex2, scope.blockSize2);
+
+		return scope.blockSize1 + scope.blockSize2;
+	}
+
+private:
+	juce::AbstractFifo fifo{ capacity };
+	std::array<float, capacity> buffer{};
+
+};
@@ -0,0 +1,260 @@
+/*
+  ==============================================================================
+
+    Arpeggiator.cpp
+    Created: 19 Oct 2026 5:41:09pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "Arpeggiator.h"
+
+Arpeggiator::Arpeggiator()
+{
+    for (int i = 0; i < maxSteps; ++i)
+        setStep(i, 0, 0.8f);
+}
+
+void Arpeggiator::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    // Sitio de sobra para la entrada y las notas generadas de un bloque
+    output.ensureSize(8192);
+    output.clear();
+
+    isHeld.fill(false);
+    numHeld = 0;
+    activeNote = -1;
+    stepIndex = 0;
+    samplesToNextStep = 0.0;
+}
+
+void Arpeggiator::setStep(int index, int semitones, float velocity)
+{
+    if (! juce::isPositiveAndBelow(index, maxSteps))
+        return;
+
+    stepOffsets[(size_t)index] = semitones == restStep ? restStep : juce::jlimit(-48, 48, semitones);
+    stepVelocities[(size_t)index] = juce::jlimit(0.0f, 1.0f, velocity);
+}
+
+const juce::MidiBuffer& Arpeggiator::process(const juce::MidiBuffer& input, int numSamples, juce::AudioPlayHead* playHead)
+{
+    if (mode.load(std::memory_order_relaxed) == Off)
+    {
+        if (activeNote < 0 && numHeld == 0)
+            return input;
+
+        // Se acaba de apagar: soltar la nota que sonaba y dejar pasar la entrada
+        output.clear();
+        releaseActiveNote(0);
+        isHeld.fill(false);
+        numHeld = 0;
+        output.addEvents(input, 0, numSamples, 0);
+        return output;
+    }
+
+    const double stepBeats = 1.0 / (double)(1 << rate.load(std::memory_order_relaxed));
+    double ppq = 0.0;
+    hostSynced = false;
+
+    if (playHead != nullptr)
+    {
+        if (auto position = playHead->getPosition())
+        {
+            if (auto hostBpm = position->getBpm())
+                bpm = juce::jlimit(20.0, 999.0, *hostBpm);
+
+            if (position->getIsPlaying())
+            {
+                if (auto hostPpq = position->getPpqPosition())
+                {
+                    ppq = *hostPpq;
+                    hostSynced = true;
+                }
+            }
+        }
+    }
+
+    const double samplesPerBeat = sampleRate * 60.0 / bpm;
+    const double samplesPerStep = juce::jmax(1.0, samplesPerBeat * stepBeats);
+
+    if (hostSynced)
+    {
+        // Con el transporte en marcha los pasos caen en la rejilla del host
+        stepIndex = (juce::int64)std::ceil(ppq / stepBeats - 1.0e-9);
+        samplesToNextStep = juce::jmax(0.0, ((double)stepIndex * stepBeats - ppq) * samplesPerBeat);
+    }
+    else
+    {
+        samplesToNextStep = juce::jmin(samplesToNextStep, samplesPerStep);
+    }
+
+    output.clear();
+
+    // Mezcla en orden de la entrada, los note-off pendientes y los pasos:
+    // cada evento se anade despues del anterior, no hace falta ordenar
+    auto inputIt = input.begin();
+    double nextStep = samplesToNextStep;
+
+    for (;;)
+    {
+        const int inputTime = inputIt != input.end() ? (*inputIt).samplePosition : numSamples;
+        const int noteOffTime = activeNote >= 0 ? samplesToNoteOff : numSamples;
+        const int stepTime = (int)nextStep;
+
+        if (inputTime >= numSamples && noteOffTime >= numSamples && stepTime >= numSamples)
+            break;
+
+        if (inputTime <= noteOffTime && inputTime <= stepTime)
+        {
+            handleInput((*inputIt).getMessage(), inputTime, nextStep);
+            ++inputIt;
+        }
+        else if (noteOffTime <= stepTime)
+        {
+            releaseActiveNote(noteOffTime);
+        }
+        else
+        {
+            playStep(stepTime, samplesPerStep);
+            nextStep += samplesPerStep;
+        }
+    }
+
+    samplesToNextStep = nextStep - (double)numSamples;
+
+    if (activeNote >= 0)
+        samplesToNoteOff -= numSamples;
+
+    return output;
+}
+
+void Arpeggiator::handleInput(const juce::MidiMessage& message, int samplePosition, double& nextStep)
+{
+    if (message.isNoteOn())
+    {
+        const int note = message.getNoteNumber();
+
+        // Sin transporte la primera nota arranca el patron en ese instante
+        if (numHeld == 0 && ! hostSynced)
+        {
+            nextStep = (double)samplePosition;
+            stepIndex = 0;
+        }
+
+        isHeld[(size_t)note] = true;
+        heldVelocities[(size_t)note] = message.getVelocity();
+        lastNote = note;
+        midiChannel = message.getChannel();
+        updateHeldNotes();
+    }
+    else if (message.isNoteOff())
+    {
+        const int note = message.getNoteNumber();
+
+        // Notas que empezaron antes de encender el arpegiador
+        if (! isHeld[(size_t)note])
+        {
+            output.addEvent(message, samplePosition);
+            return;
+        }
+
+        isHeld[(size_t)note] = false;
+        updateHeldNotes();
+
+        if (numHeld == 0)
+            releaseActiveNote(samplePosition);
+    }
+    else
+    {
+        if (message.isAllNotesOff() || message.isAllSoundOff())
+        {
+            isHeld.fill(false);
+            numHeld = 0;
+            releaseActiveNote(samplePosition);
+        }
+
+        output.addEvent(message, samplePosition);
+    }
+}
+
+void Arpeggiator::updateHeldNotes()
+{
+    // Recorrer las 128 notas deja la lista ordenada sin ordenar nada
+    numHeld = 0;
+
+    for (int note = 0; note < 128; ++note)
+        if (isHeld[(size_t)note])
+            heldNotes[(size_t)numHeld++] = note;
+}
+
+void Arpeggiator::playStep(int samplePosition, double samplesPerStep)
+{
+    const auto index = stepIndex++;
+
+    releaseActiveNote(samplePosition);
+
+    if (numHeld == 0)
+        return;
+
+    const int currentMode = mode.load(std::memory_order_relaxed);
+    int note = -1;
+    float velocity = 0.0f;
+
+    if (currentMode == Sequencer)
+    {
+        const int steps = numSteps.load(std::memory_order_relaxed);
+        const int step = (int)(((index % steps) + steps) % steps);
+        const int offset = stepOffsets[(size_t)step].load(std::memory_order_relaxed);
+
+        if (offset == restStep || lastNote < 0)
+            return;
+
+        note = lastNote + offset;
+        velocity = stepVelocities[(size_t)step].load(std::memory_order_relaxed);
+    }
+    else
+    {
+        const int numNotes = numHeld * octaves.load(std::memory_order_relaxed);
+        const int position = (int)(((index % numNotes) + numNotes) % numNotes);
+        int i = position;
+
+        if (currentMode == Down)
+        {
+            i = numNotes - 1 - position;
+        }
+        else if (currentMode == UpDown)
+        {
+            const int period = juce::jmax(1, 2 * (numNotes - 1));
+            const int k = (int)(((index % period) + period) % period);
+            i = k < numNotes ? k : period - k;
+        }
+        else if (currentMode == Random)
+        {
+            i = random.nextInt(numNotes);
+        }
+
+        const int heldNote = heldNotes[(size_t)(i % numHeld)];
+        note = heldNote + 12 * (i / numHeld);
+        velocity = heldVelocities[(size_t)heldNote] / 127.0f;
+    }
+
+    if (! juce::isPositiveAndBelow(note, 128) || velocity <= 0.0f)
+        return;
+
+    output.addEvent(juce::MidiMessage::noteOn(midiChannel, note, velocity), samplePosition);
+    activeNote = note;
+    samplesToNoteOff = samplePosition + juce::jmax(1, (int)(samplesPerStep * gate.load(std::memory_order_relaxed)));
+}
+
+void Arpeggiator::releaseActiveNote(int samplePosition)
+{
+    if (activeNote < 0)
+        return;
+
+    output.addEvent(juce::MidiMessage::noteOff(midiChannel, activeNote), samplePosition);
+    activeNote = -1;
+}
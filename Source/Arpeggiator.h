@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+	Arpeggiator.h
+	Created: 19 Oct 2026 5:41:09pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Arpegiador y secuenciador de pasos que corre en processBlock antes del
+// sintetizador. Genera las notas en un MidiBuffer reservado en prepareToPlay y
+// las mezcla en orden con la entrada, sin ordenar ni reservar memoria.
+class Arpeggiator {
+
+public:
+	enum Mode {
+		Off = 0,
+		Up,
+		Down,
+		UpDown,
+		Random,
+		Sequencer
+	};
+
+	// Duracion de cada paso: negra, corchea, ... hasta semifusa (1/64)
+	enum Rate {
+		Quarter = 0,
+		Eighth,
+		Sixteenth,
+		ThirtySecond,
+		SixtyFourth
+	};
+
+	static constexpr int maxSteps = 16;
+	static constexpr int restStep = -128;
+
+	Arpeggiator();
+
+	void prepare(double sampleRate);
+
+	// Hilo de audio. Devuelve la entrada tal cual si esta apagado o el buffer
+	// con las notas generadas si no.
+	const juce::MidiBuffer& process(const juce::MidiBuffer& input, int numSamples, juce::AudioPlayHead* playHead);
+
+	// Hilo de mensajes
+	void setMode(int newMode) { mode = juce::jlimit((int)Off, (int)Sequencer, newMode); }
+	int getMode() const { return mode.load(); }
+	void setRate(int newRate) { rate = juce::jlimit((int)Quarter, (int)SixtyFourth, newRate); }
+	int getRate() const { return rate.load(); }
+	void setGate(float newGate) { gate = juce::jlimit(0.05f, 1.0f, newGate); }
+	float getGate() const { return gate.load(); }
+	void setOctaves(int newOctaves) { octaves = juce::jlimit(1, 4, newOctaves); }
+	int getOctaves() const { return octaves.load(); }
+
+	// Pasos del secuenciador: semitonos sobre la ultima nota pulsada (restStep = silencio)
+	void setNumSteps(int newNumSteps) { numSteps = juce::jlimit(1, maxSteps, newNumSteps); }
+	int getNumSteps() const { return numSteps.load(); }
+	void setStep(int index, int semitones, float velocity);
+	int getStepOffset(int index) const { return stepOffsets[(size_t)index].load(); }
+	float getStepVelocity(int index) const { return stepVelocities[(size_t)index].load(); }
+
+private:
+	void handleInput(const juce::MidiMessage& message, int samplePosition, double& nextStep);
+	void updateHeldNotes();
+	void playStep(int samplePosition, double samplesPerStep);
+	void releaseActiveNote(int samplePosition);
+
+	std::atomic<int> mode{ Off };
+	std::atomic<int> rate{ Sixteenth };
+	std::atomic<float> gate{ 0.5f };
+	std::atomic<int> octaves{ 1 };
+	std::atomic<int> numSteps{ maxSteps };
+	std::array<std::atomic<int>, maxSteps> stepOffsets{};
+	std::array<std::atomic<float>, maxSteps> stepVelocities{};
+
+	// Solo hilo de audio
+	double sampleRate = 44100.0;
+	double bpm = 120.0;
+	juce::MidiBuffer output;
+	juce::Random random;
+
+	std::array<bool, 128> isHeld{};
+	std::array<juce::uint8, 128> heldVelocities{};
+	std::array<int, 128> heldNotes{};	// notas pulsadas de grave a agudo
+	int numHeld = 0;
+	int lastNote = -1;
+	int midiChannel = 1;
+
+	juce::int64 stepIndex = 0;
+	double samplesToNextStep = 0.0;
+
+	int activeNote = -1;
+	int samplesToNoteOff = 0;
+	bool hostSynced = false;
+
+};
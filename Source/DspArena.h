@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+	DspArena.h
+	Created: 19 Oct 2026 2:31:05pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Bloque de memoria contiguo del que se reparten los buffers de las voces y de
+// la instancia. Se reserva entero en prepareToPlay y se reparte en el mismo
+// orden en que luego se recorre al renderizar.
+class DspArena {
+
+public:
+	static constexpr size_t alignment = 64;
+
+	static constexpr size_t alignedSize(size_t numBytes) noexcept
+	{
+		return (numBytes + alignment - 1) & ~(alignment - 1);
+	}
+
+	static constexpr size_t bytesForFloats(int numFloats) noexcept
+	{
+		return alignedSize(sizeof(float) * (size_t)juce::jmax(0, numFloats));
+	}
+
+	// Invalida todo lo repartido antes. Solo fuera del hilo de audio.
+	void reset(size_t totalBytes)
+	{
+		if (totalBytes + alignment > storageSize)
+		{
+			storageSize = totalBytes + alignment;
+			storage.allocate(storageSize, true);
+		}
+		else
+		{
+			storage.clear(storageSize);
+		}
+
+		const auto address = reinterpret_cast<uintptr_t>(storage.get());
+		base = storage.get() + (alignedSize(address) - address);
+		capacity = totalBytes;
+		used = 0;
+	}
+
+	float* allocateFloats(int numFloats) noexcept
+	{
+		const auto numBytes = bytesForFloats(numFloats);
+		jassert(used + numBytes <= capacity);
+
+		auto* data = reinterpret_cast<float*>(base + used);
+		used += numBytes;
+		return data;
+	}
+
+	size_t getCapacity() const noexcept { return capacity; }
+	size_t getBytesUsed() const noexcept { return used; }
+
+private:
+	juce::HeapBlock<char> storage;
+	size_t storageSize = 0;
+	char* base = nullptr;
+	size_t capacity = 0;
+	size_t used = 0;
+
+};
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    DspKernels.cpp
+    Created: 19 Oct 2026 10:02:14am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+namespace
+{
+    void renderWavetableScalar(float* dest, int numSamples, const float* table, int tableSize, float& phase, float phaseIncrement)
+    {
+        const auto size = (float)tableSize;
+        auto p = phase;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto index = (int)p;
+            const auto frac = p - (float)index;
+            dest[i] = table[index] + frac * (table[index + 1] - table[index]);
+
+            p += phaseIncrement;
+            if (p >= size)
+                p -= size;
+        }
+
+        phase = p;
+    }
+
+    void renderWavetableMorphScalar(float* dest, int numSamples, const float* levels, int frameSize, int numFrames, float levelMix,
+                                    float& phase, float phaseIncrement, float position, float positionIncrement)
+    {
+        const auto sizeB = frameSize / 2;
+        const auto* levelB = levels + numFrames * (frameSize + 1);
+        auto p = phase;
+
+        // Interpolacion lineal dentro del frame y entre el frame y el siguiente
+        auto lookup = [](const float* level, int stride, int frame, float frameFrac, float x) {
+            const auto index = (int)x;
+            const auto frac = x - (float)index;
+            const auto* a = level + frame * stride + index;
+            const auto* b = a + stride;
+            const auto sampleA = a[0] + frac * (a[1] - a[0]);
+            const auto sampleB = b[0] + frac * (b[1] - b[0]);
+            return sampleA + frameFrac * (sampleB - sampleA);
+            };
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto framePosition = position + positionIncrement * (float)i;
+            const auto frame = juce::jmin((int)framePosition, numFrames - 2);
+            const auto frameFrac = framePosition - (float)frame;
+
+            const auto fine = lookup(levels, frameSize + 1, frame, frameFrac, p * (float)frameSize);
+            const auto coarse = lookup(levelB, sizeB + 1, frame, frameFrac, p * (float)sizeB);
+            dest[i] = fine + levelMix * (coarse - fine);
+
+            p += phaseIncrement;
+            if (p >= 1.0f)
+                p -= 1.0f;
+        }
+
+        phase = p;
+    }
+
+    void multiplyScalar(float* dest, const float* envelope, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] *= envelope[i];
+    }
+
+    void applyGainRampScalar(float* dest, int numSamples, float startGain, float endGain)
+    {
+        const auto step = numSamples > 0 ? (endGain - startGain) / (float)numSamples : 0.0f;
+
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] *= startGain + step * (float)i;
+    }
+
+    void addWithGainScalar(float* dest, const float* src, int numSamples, float gain)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] += src[i] * gain;
+    }
+
+    void readDelayStereoScalar(float* left, float* right, const float* frames, int mask, int writeIndex, const float* delays, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Puntos en los retardos D + 2, D + 1, D y D - 1; se lee en D + f
+            const auto whole = (int)delays[i];
+            const auto f = delays[i] - (float)whole;
+            const auto a = 1.0f - f, b = 1.0f + f, c = 2.0f - f;
+            const auto c0 = -a * f * b * (1.0f / 6.0f);
+            const auto c1 = c * f * b * 0.5f;
+            const auto c2 = c * a * b * 0.5f;
+            const auto c3 = -c * a * f * (1.0f / 6.0f);
+
+            const auto* p = frames + 2 * ((writeIndex + i - whole - 2) & mask);
+            left[i] = c0 * p[0] + c1 * p[2] + c2 * p[4] + c3 * p[6];
+            right[i] = c0 * p[1] + c1 * p[3] + c2 * p[5] + c3 * p[7];
+        }
+    }
+
+    // sin(2 * pi * t) con t en ciclos. Parabola con una correccion (error maximo ~0.001)
+    inline float fastSinCycles(float t) noexcept
+    {
+        t -= std::floor(t + 0.5f);
+        const auto y = 8.0f * t - 16.0f * t * std::abs(t);
+        return 0.225f * (y * std::abs(y) - y) + y;
+    }
+
+    void renderFmScalar(float* dest, int numSamples, DspKernels::FmState& state, float& cyclesPerSample, float glideRatio)
+    {
+        auto cycles = cyclesPerSample;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Modulacion con las salidas de la muestra anterior
+            std::array<float, 4> modulation{};
+
+            for (size_t source = 0; source < 4; ++source)
+                for (size_t op = 0; op < 4; ++op)
+                    modulation[op] += state.modulators[source][op] * state.outputs[source];
+
+            std::array<float, 4> carriers{};
+
+            for (size_t op = 0; op < 4; ++op)
+            {
+                auto phase = state.phases[op] + state.ratios[op] * cycles;
+                phase -= (float)(int)phase;
+                state.phases[op] = phase;
+
+                state.envelopeValues[op] += state.envelopeSteps[op];
+                state.outputs[op] = fastSinCycles(phase + modulation[op]) * state.levels[op] * state.envelopeValues[op];
+                carriers[op] = state.outputs[op] * state.carrierGains[op];
+            }
+
+            // Misma suma por parejas que las variantes SIMD
+            dest[i] = (carriers[0] + carriers[2]) + (carriers[1] + carriers[3]);
+            cycles *= glideRatio;
+        }
+
+        cyclesPerSample = cycles;
+    }
+
+    const DspKernels scalarKernels{
+        "Scalar",
+        DspKernels::Isa::Scalar,
+        renderWavetableScalar,
+        renderWavetableMorphScalar,
+        multiplyScalar,
+        applyGainRampScalar,
+        addWithGainScalar,
+        readDelayStereoScalar,
+        renderFmScalar
+    };
+
+    std::atomic<const DspKernels*> overrideKernels{ nullptr };
+}
+
+const DspKernels* DspKernelVariants::getScalar()
+{
+    return &scalarKernels;
+}
+
+juce::Array<const DspKernels*> DspKernels::getAvailable()
+{
+    // Ordenadas de menor a mayor: la ultima es la mejor que soporta esta CPU
+    juce::Array<const DspKernels*> available{ DspKernelVariants::getScalar() };
+
+    if (auto* k = DspKernelVariants::getSSE2(); k != nullptr && juce::SystemStats::hasSSE2())
+        available.add(k);
+
+    if (auto* k = DspKernelVariants::getAVX2(); k != nullptr && juce::SystemStats::hasAVX2())
+        available.add(k);
+
+    if (auto* k = DspKernelVariants::getAVX512(); k != nullptr && juce::SystemStats::hasAVX512F())
+        available.add(k);
+
+    return available;
+}
+
+const DspKernels& DspKernels::get()
+{
+    static const DspKernels& selected = *getAvailable().getLast();
+
+    if (auto* pinned = overrideKernels.load(std::memory_order_relaxed))
+        return *pinned;
+
+    return selected;
+}
+
+void DspKernels::setOverride(const DspKernels* kernels)
+{
+    overrideKernels.store(kernels, std::memory_order_relaxed);
+}
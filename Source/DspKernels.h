@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+	DspKernels.h
+	Created: 19 Oct 2026 10:02:14am
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Bucles calientes del motor con una variante compilada por cada juego de
+// instrucciones. La mejor variante se elige una sola vez (DspKernels::get()),
+// salvo que se fije otra con setOverride.
+struct DspKernels
+{
+	enum class Isa
+	{
+		Scalar = 0,
+		SSE2,
+		AVX2,
+		AVX512
+	};
+
+	// Estado de los 4 operadores FM de una voz (ver FmOperators), un carril por operador
+	struct FmState
+	{
+		alignas(16) std::array<float, 4> phases{};			// en ciclos [0, 1)
+		alignas(16) std::array<float, 4> outputs{};			// salida de la muestra anterior
+		alignas(16) std::array<float, 4> ratios{};
+		alignas(16) std::array<float, 4> levels{};
+		alignas(16) std::array<float, 4> carrierGains{};
+		alignas(16) std::array<float, 4> envelopeValues{};
+		alignas(16) std::array<float, 4> envelopeSteps{};
+		// modulators[fuente][destino]: cuanto modula la salida de cada operador a cada operador
+		alignas(16) std::array<std::array<float, 4>, 4> modulators{};
+	};
+
+	const char* name;
+	Isa isa;
+
+	// Oscilador por tabla con interpolacion lineal. La tabla tiene tableSize + 1
+	// puntos (el ultimo repite el primero) y la fase va en unidades de indice.
+	void (*renderWavetable)(float* dest, int numSamples, const float* table, int tableSize, float& phase, float phaseIncrement);
+	// Oscilador de tabla con morphing entre frames y entre dos niveles mip (ver
+	// Wavetable). levels apunta al primer frame del nivel fino (frameSize + 1
+	// puntos por frame) y el nivel grueso, de frameSize / 2, va justo detras. La
+	// fase va en ciclos [0, 1) y la posicion en frames [0, numFrames - 1], con
+	// una rampa lineal de positionIncrement por muestra. levelMix 0 = nivel fino.
+	void (*renderWavetableMorph)(float* dest, int numSamples, const float* levels, int frameSize, int numFrames, float levelMix,
+	                             float& phase, float phaseIncrement, float position, float positionIncrement);
+	// Aplicar la envolvente: dest[i] *= envelope[i]
+	void (*multiply)(float* dest, const float* envelope, int numSamples);
+	// Ganancia con rampa lineal de startGain a endGain
+	void (*applyGainRamp)(float* dest, int numSamples, float startGain, float endGain);
+	// Suma de voces: dest[i] += src[i] * gain
+	void (*addWithGain)(float* dest, const float* src, int numSamples, float gain);
+	// Lectura de una linea de retardo estereo intercalada (L, R por frame) con
+	// retardo fraccionario, Lagrange de orden 3 con los mismos coeficientes para
+	// los dos canales. frames tiene mask + 1 frames y 3 mas de guarda que repiten
+	// los primeros. delays[i] es el retardo en muestras de la muestra que se
+	// escribira en writeIndex + i; tiene que ser >= numSamples + 2 para que todo
+	// lo que se lee ya este escrito.
+	void (*readDelayStereo)(float* left, float* right, const float* frames, int mask, int writeIndex, const float* delays, int numSamples);
+	// Operadores FM: cada operador se modula con las salidas de la muestra anterior,
+	// asi los 4 se calculan a la vez. Las envolventes avanzan envelopeSteps por
+	// muestra y la frecuencia base (cyclesPerSample) se multiplica por glideRatio.
+	// dest recibe la suma de los portadores.
+	void (*renderFm)(float* dest, int numSamples, FmState& state, float& cyclesPerSample, float glideRatio);
+
+	static const DspKernels& get();
+	static juce::Array<const DspKernels*> getAvailable();
+	// Fija la variante de todas las instancias, para renders que no pueden depender
+	// de la CPU (referencias de GoldenAudio); nullptr vuelve a la mejor. Cambiarla
+	// mientras suena mezcla variantes dentro de un bloque.
+	static void setOverride(const DspKernels* kernels);
+};
+
+namespace DspKernelVariants
+{
+	const DspKernels* getScalar();
+	const DspKernels* getSSE2();
+	const DspKernels* getAVX2();
+	const DspKernels* getAVX512();
+}
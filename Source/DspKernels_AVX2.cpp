@@ -0,0 +1,237 @@
+/*
+  ==============================================================================
+
+    DspKernels_AVX2.cpp
+    Created: 19 Oct 2026 10:02:14am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if JUCE_INTEL
+
+#include <immintrin.h>
+
+#if JUCE_GCC || JUCE_CLANG
+ #define DSP_KERNEL_TARGET __attribute__((target("avx2")))
+#else
+ #define DSP_KERNEL_TARGET
+#endif
+
+namespace
+{
+    DSP_KERNEL_TARGET void renderWavetableAVX2(float* dest, int numSamples, const float* table, int tableSize, float& phase, float phaseIncrement)
+    {
+        const auto size = _mm256_set1_ps((float)tableSize);
+        const auto invSize = _mm256_set1_ps(1.0f / (float)tableSize);
+        const auto step = _mm256_set1_ps(8.0f * phaseIncrement);
+        const auto one = _mm256_set1_epi32(1);
+
+        auto p = _mm256_add_ps(_mm256_set1_ps(phase),
+                               _mm256_mul_ps(_mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f), _mm256_set1_ps(phaseIncrement)));
+        p = _mm256_sub_ps(p, _mm256_mul_ps(size, _mm256_floor_ps(_mm256_mul_ps(p, invSize))));
+
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const auto index = _mm256_cvttps_epi32(p);
+            const auto frac = _mm256_sub_ps(p, _mm256_cvtepi32_ps(index));
+            const auto a = _mm256_i32gather_ps(table, index, 4);
+            const auto b = _mm256_i32gather_ps(table, _mm256_add_epi32(index, one), 4);
+            _mm256_storeu_ps(dest + i, _mm256_add_ps(a, _mm256_mul_ps(frac, _mm256_sub_ps(b, a))));
+
+            p = _mm256_add_ps(p, step);
+            p = _mm256_sub_ps(p, _mm256_mul_ps(size, _mm256_floor_ps(_mm256_mul_ps(p, invSize))));
+        }
+
+        phase = _mm256_cvtss_f32(p);
+
+        if (i < numSamples)
+            DspKernelVariants::getScalar()->renderWavetable(dest + i, numSamples - i, table, tableSize, phase, phaseIncrement);
+    }
+
+    // Dos frames vecinos interpolados en x; frameOffset = frame * stride
+    DSP_KERNEL_TARGET inline __m256 lookupFramesAVX2(const float* level, __m256i stride, __m256i frameOffset, __m256 frameFrac, __m256 x)
+    {
+        const auto one = _mm256_set1_epi32(1);
+        const auto index = _mm256_cvttps_epi32(x);
+        const auto frac = _mm256_sub_ps(x, _mm256_cvtepi32_ps(index));
+        const auto indexA = _mm256_add_epi32(frameOffset, index);
+        const auto indexB = _mm256_add_epi32(indexA, stride);
+
+        const auto a0 = _mm256_i32gather_ps(level, indexA, 4);
+        const auto a1 = _mm256_i32gather_ps(level, _mm256_add_epi32(indexA, one), 4);
+        const auto b0 = _mm256_i32gather_ps(level, indexB, 4);
+        const auto b1 = _mm256_i32gather_ps(level, _mm256_add_epi32(indexB, one), 4);
+
+        const auto sampleA = _mm256_add_ps(a0, _mm256_mul_ps(frac, _mm256_sub_ps(a1, a0)));
+        const auto sampleB = _mm256_add_ps(b0, _mm256_mul_ps(frac, _mm256_sub_ps(b1, b0)));
+        return _mm256_add_ps(sampleA, _mm256_mul_ps(frameFrac, _mm256_sub_ps(sampleB, sampleA)));
+    }
+
+    DSP_KERNEL_TARGET void renderWavetableMorphAVX2(float* dest, int numSamples, const float* levels, int frameSize, int numFrames, float levelMix,
+                                                    float& phase, float phaseIncrement, float position, float positionIncrement)
+    {
+        const auto sizeB = frameSize / 2;
+        const auto* levelB = levels + numFrames * (frameSize + 1);
+        const auto lanes = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+        const auto sizeA = _mm256_set1_ps((float)frameSize);
+        const auto sizeBv = _mm256_set1_ps((float)sizeB);
+        const auto strideA = _mm256_set1_epi32(frameSize + 1);
+        const auto strideB = _mm256_set1_epi32(sizeB + 1);
+        const auto lastFrame = _mm256_set1_epi32(numFrames - 2);
+        const auto mix = _mm256_set1_ps(levelMix);
+        const auto step = _mm256_set1_ps(8.0f * phaseIncrement);
+        const auto positionStep = _mm256_set1_ps(8.0f * positionIncrement);
+
+        auto p = _mm256_add_ps(_mm256_set1_ps(phase), _mm256_mul_ps(lanes, _mm256_set1_ps(phaseIncrement)));
+        p = _mm256_sub_ps(p, _mm256_floor_ps(p));
+        auto framePosition = _mm256_add_ps(_mm256_set1_ps(position), _mm256_mul_ps(lanes, _mm256_set1_ps(positionIncrement)));
+
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const auto frame = _mm256_min_epi32(_mm256_cvttps_epi32(framePosition), lastFrame);
+            const auto frameFrac = _mm256_sub_ps(framePosition, _mm256_cvtepi32_ps(frame));
+
+            const auto fine = lookupFramesAVX2(levels, strideA, _mm256_mullo_epi32(frame, strideA), frameFrac, _mm256_mul_ps(p, sizeA));
+            const auto coarse = lookupFramesAVX2(levelB, strideB, _mm256_mullo_epi32(frame, strideB), frameFrac, _mm256_mul_ps(p, sizeBv));
+            _mm256_storeu_ps(dest + i, _mm256_add_ps(fine, _mm256_mul_ps(mix, _mm256_sub_ps(coarse, fine))));
+
+            p = _mm256_add_ps(p, step);
+            p = _mm256_sub_ps(p, _mm256_floor_ps(p));
+            framePosition = _mm256_add_ps(framePosition, positionStep);
+        }
+
+        phase = _mm256_cvtss_f32(p);
+
+        if (i < numSamples)
+            DspKernelVariants::getScalar()->renderWavetableMorph(dest + i, numSamples - i, levels, frameSize, numFrames, levelMix,
+                                                                 phase, phaseIncrement, position + positionIncrement * (float)i, positionIncrement);
+    }
+
+    DSP_KERNEL_TARGET void multiplyAVX2(float* dest, const float* envelope, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+            _mm256_storeu_ps(dest + i, _mm256_mul_ps(_mm256_loadu_ps(dest + i), _mm256_loadu_ps(envelope + i)));
+
+        for (; i < numSamples; ++i)
+            dest[i] *= envelope[i];
+    }
+
+    DSP_KERNEL_TARGET void applyGainRampAVX2(float* dest, int numSamples, float startGain, float endGain)
+    {
+        const auto delta = numSamples > 0 ? (endGain - startGain) / (float)numSamples : 0.0f;
+        auto g = _mm256_add_ps(_mm256_set1_ps(startGain),
+                               _mm256_mul_ps(_mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f), _mm256_set1_ps(delta)));
+        const auto step = _mm256_set1_ps(8.0f * delta);
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            _mm256_storeu_ps(dest + i, _mm256_mul_ps(_mm256_loadu_ps(dest + i), g));
+            g = _mm256_add_ps(g, step);
+        }
+
+        for (; i < numSamples; ++i)
+            dest[i] *= startGain + delta * (float)i;
+    }
+
+    DSP_KERNEL_TARGET void addWithGainAVX2(float* dest, const float* src, int numSamples, float gain)
+    {
+        const auto g = _mm256_set1_ps(gain);
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+            _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+
+        for (; i < numSamples; ++i)
+            dest[i] += src[i] * gain;
+    }
+
+    DSP_KERNEL_TARGET void readDelayStereoAVX2(float* left, float* right, const float* frames, int mask, int writeIndex, const float* delays, int numSamples)
+    {
+        const auto one = _mm256_set1_ps(1.0f);
+        const auto two = _mm256_set1_ps(2.0f);
+        const auto half = _mm256_set1_ps(0.5f);
+        const auto minusSixth = _mm256_set1_ps(-1.0f / 6.0f);
+        const auto maskv = _mm256_set1_epi32(mask);
+
+        alignas(32) float c0[8], c1[8], c2[8], c3[8];
+        alignas(32) int base[8];
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            // Coeficientes de ocho muestras a la vez
+            const auto d = _mm256_loadu_ps(delays + i);
+            const auto whole = _mm256_cvttps_epi32(d);
+            const auto f = _mm256_sub_ps(d, _mm256_cvtepi32_ps(whole));
+            const auto a = _mm256_sub_ps(one, f);
+            const auto b = _mm256_add_ps(one, f);
+            const auto c = _mm256_sub_ps(two, f);
+            const auto fb = _mm256_mul_ps(f, b);
+            const auto ca = _mm256_mul_ps(c, a);
+
+            _mm256_store_ps(c0, _mm256_mul_ps(_mm256_mul_ps(a, fb), minusSixth));
+            _mm256_store_ps(c1, _mm256_mul_ps(_mm256_mul_ps(c, fb), half));
+            _mm256_store_ps(c2, _mm256_mul_ps(_mm256_mul_ps(ca, b), half));
+            _mm256_store_ps(c3, _mm256_mul_ps(_mm256_mul_ps(ca, f), minusSixth));
+
+            const auto position = _mm256_add_epi32(_mm256_set1_epi32(writeIndex + i - 2), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+            _mm256_store_si256((__m256i*)base, _mm256_and_si256(_mm256_sub_epi32(position, whole), maskv));
+
+            // Cada muestra: los 4 frames (8 floats) en un solo registro, L y R juntos
+            for (int lane = 0; lane < 8; ++lane)
+            {
+                const auto coefficients = _mm256_set_ps(c3[lane], c3[lane], c2[lane], c2[lane], c1[lane], c1[lane], c0[lane], c0[lane]);
+                const auto m = _mm256_mul_ps(_mm256_loadu_ps(frames + 2 * base[lane]), coefficients);
+                auto s = _mm_add_ps(_mm256_castps256_ps128(m), _mm256_extractf128_ps(m, 1));
+                s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+                left[i + lane] = _mm_cvtss_f32(s);
+                right[i + lane] = _mm_cvtss_f32(_mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+            }
+        }
+
+        if (i < numSamples)
+            DspKernelVariants::getScalar()->readDelayStereo(left + i, right + i, frames, mask, writeIndex + i, delays + i, numSamples - i);
+    }
+
+    // Los 4 operadores FM caben en un registro de 128 bits: el ancho de SSE2 ya los cubre
+    void renderFmAVX2(float* dest, int numSamples, DspKernels::FmState& state, float& cyclesPerSample, float glideRatio)
+    {
+        DspKernelVariants::getSSE2()->renderFm(dest, numSamples, state, cyclesPerSample, glideRatio);
+    }
+
+    const DspKernels avx2Kernels{
+        "AVX2",
+        DspKernels::Isa::AVX2,
+        renderWavetableAVX2,
+        renderWavetableMorphAVX2,
+        multiplyAVX2,
+        applyGainRampAVX2,
+        addWithGainAVX2,
+        readDelayStereoAVX2,
+        renderFmAVX2
+    };
+}
+
+const DspKernels* DspKernelVariants::getAVX2()
+{
+    return &avx2Kernels;
+}
+
+#else
+
+const DspKernels* DspKernelVariants::getAVX2()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    DspKernels_AVX512.cpp
+    Created: 19 Oct 2026 10:02:14am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if JUCE_INTEL
+
+#include <immintrin.h>
+
+#if JUCE_GCC || JUCE_CLANG
+ #define DSP_KERNEL_TARGET __attribute__((target("avx512f")))
+#else
+ #define DSP_KERNEL_TARGET
+#endif
+
+namespace
+{
+    DSP_KERNEL_TARGET void renderWavetableAVX512(float* dest, int numSamples, const float* table, int tableSize, float& phase, float phaseIncrement)
+    {
+        const auto size = _mm512_set1_ps((float)tableSize);
+        const auto invSize = _mm512_set1_ps(1.0f / (float)tableSize);
+        const auto step = _mm512_set1_ps(16.0f * phaseIncrement);
+        const auto one = _mm512_set1_epi32(1);
+        const auto lanes = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f,
+                                         7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+        auto p = _mm512_add_ps(_mm512_set1_ps(phase), _mm512_mul_ps(lanes, _mm512_set1_ps(phaseIncrement)));
+        p = _mm512_sub_ps(p, _mm512_mul_ps(size, _mm512_roundscale_ps(_mm512_mul_ps(p, invSize), _MM_FROUND_TO_NEG_INF)));
+
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            const auto index = _mm512_cvttps_epi32(p);
+            const auto frac = _mm512_sub_ps(p, _mm512_cvtepi32_ps(index));
+            const auto a = _mm512_i32gather_ps(index, table, 4);
+            const auto b = _mm512_i32gather_ps(_mm512_add_epi32(index, one), table, 4);
+            _mm512_storeu_ps(dest + i, _mm512_add_ps(a, _mm512_mul_ps(frac, _mm512_sub_ps(b, a))));
+
+            p = _mm512_add_ps(p, step);
+            p = _mm512_sub_ps(p, _mm512_mul_ps(size, _mm512_roundscale_ps(_mm512_mul_ps(p, invSize), _MM_FROUND_TO_NEG_INF)));
+        }
+
+        phase = _mm512_cvtss_f32(p);
+
+        if (i < numSamples)
+            DspKernelVariants::getScalar()->renderWavetable(dest + i, numSamples - i, table, tableSize, phase, phaseIncrement);
+    }
+
+    // Dos frames vecinos interpolados en x; frameOffset = frame * stride
+    DSP_KERNEL_TARGET inline __m512 lookupFramesAVX512(const float* level, __m512i stride, __m512i frameOffset, __m512 frameFrac, __m512 x)
+    {
+        const auto one = _mm512_set1_epi32(1);
+        const auto index = _mm512_cvttps_epi32(x);
+        const auto frac = _mm512_sub_ps(x, _mm512_cvtepi32_ps(index));
+        const auto indexA = _mm512_add_epi32(frameOffset, index);
+        const auto indexB = _mm512_add_epi32(indexA, stride);
+
+        const auto a0 = _mm512_i32gather_ps(indexA, level, 4);
+        const auto a1 = _mm512_i32gather_ps(_mm512_add_epi32(indexA, one), level, 4);
+        const auto b0 = _mm512_i32gather_ps(indexB, level, 4);
+        const auto b1 = _mm512_i32gather_ps(_mm512_add_epi32(indexB, one), level, 4);
+
+        const auto sampleA = _mm512_add_ps(a0, _mm512_mul_ps(frac, _mm512_sub_ps(a1, a0)));
+        const auto sampleB = _mm512_add_ps(b0, _mm512_mul_ps(frac, _mm512_sub_ps(b1, b0)));
+        return _mm512_add_ps(sampleA, _mm512_mul_ps(frameFrac, _mm512_sub_ps(sampleB, sampleA)));
+    }
+
+    DSP_KERNEL_TARGET void renderWavetableMorphAVX512(float* dest, int numSamples, const float* levels, int frameSize, int numFrames, float levelMix,
+                                                    float& phase, float phaseIncrement, float position, float positionIncrement)
+    {
+        const auto sizeB = frameSize / 2;
+        const auto* levelB = levels + numFrames * (frameSize + 1);
+        const auto lanes = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f,
+                                         7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+        const auto sizeA = _mm512_set1_ps((float)frameSize);
+        const auto sizeBv = _mm512_set1_ps((float)sizeB);
+        const auto strideA = _mm512_set1_epi32(frameSize + 1);
+        const auto strideB = _mm512_set1_epi32(sizeB + 1);
+        const auto lastFrame = _mm512_set1_epi32(numFrames - 2);
+        const auto mix = _mm512_set1_ps(levelMix);
+        const auto step = _mm512_set1_ps(16.0f * phaseIncrement);
+        const auto positionStep = _mm512_set1_ps(16.0f * positionIncrement);
+
+        auto p = _mm512_add_ps(_mm512_set1_ps(phase), _mm512_mul_ps(lanes, _mm512_set1_ps(phaseIncrement)));
+        p = _mm512_sub_ps(p, _mm512_roundscale_ps(p, _MM_FROUND_TO_NEG_INF));
+        auto framePosition = _mm512_add_ps(_mm512_set1_ps(position), _mm512_mul_ps(lanes, _mm512_set1_ps(positionIncrement)));
+
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            const auto frame = _mm512_min_epi32(_mm512_cvttps_epi32(framePosition), lastFrame);
+            const auto frameFrac = _mm512_sub_ps(framePosition, _mm512_cvtepi32_ps(frame));
+
+            const auto fine = lookupFramesAVX512(levels, strideA, _mm512_mullo_epi32(frame, strideA), frameFrac, _mm512_mul_ps(p, sizeA));
+            const auto coarse = lookupFramesAVX512(levelB, strideB, _mm512_mullo_epi32(frame, strideB), frameFrac, _mm512_mul_ps(p, sizeBv));
+            _mm512_storeu_ps(dest + i, _mm512_add_ps(fine, _mm512_mul_ps(mix, _mm512_sub_ps(coarse, fine))));
+
+            p = _mm512_add_ps(p, step);
+            p = _mm512_sub_ps(p, _mm512_roundscale_ps(p, _MM_FROUND_TO_NEG_INF));
+            framePosition = _mm512_add_ps(framePosition, positionStep);
+        }
+
+        phase = _mm512_cvtss_f32(p);
+
+        if (i < numSamples)
+            DspKernelVariants::getScalar()->renderWavetableMorph(dest + i, numSamples - i, levels, frameSize, numFrames, levelMix,
+                                                                 phase, phaseIncrement, position + positionIncrement * (float)i, positionIncrement);
+    }
+
+    DSP_KERNEL_TARGET void multiplyAVX512(float* dest, const float* envelope, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+            _mm512_storeu_ps(dest + i, _mm512_mul_ps(_mm512_loadu_ps(dest + i), _mm512_loadu_ps(envelope + i)));
+
+        for (; i < numSamples; ++i)
+            dest[i] *= envelope[i];
+    }
+
+    DSP_KERNEL_TARGET void applyGainRampAVX512(float* dest, int numSamples, float startGain, float endGain)
+    {
+        const auto delta = numSamples > 0 ? (endGain - startGain) / (float)numSamples : 0.0f;
+        const auto lanes = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f,
+                                         7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+        auto g = _mm512_add_ps(_mm512_set1_ps(startGain), _mm512_mul_ps(lanes, _mm512_set1_ps(delta)));
+        const auto step = _mm512_set1_ps(16.0f * delta);
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            _mm512_storeu_ps(dest + i, _mm512_mul_ps(_mm512_loadu_ps(dest + i), g));
+            g = _mm512_add_ps(g, step);
+        }
+
+        for (; i < numSamples; ++i)
+            dest[i] *= startGain + delta * (float)i;
+    }
+
+    DSP_KERNEL_TARGET void addWithGainAVX512(float* dest, const float* src, int numSamples, float gain)
+    {
+        const auto g = _mm512_set1_ps(gain);
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+            _mm512_storeu_ps(dest + i, _mm512_add_ps(_mm512_loadu_ps(dest + i), _mm512_mul_ps(_mm512_loadu_ps(src + i), g)));
+
+        for (; i < numSamples; ++i)
+            dest[i] += src[i] * gain;
+    }
+
+    // Una muestra estereo con 4 puntos son 8 floats: el ancho de AVX2 ya la cubre
+    void readDelayStereoAVX512(float* left, float* right, const float* frames, int mask, int writeIndex, const float* delays, int numSamples)
+    {
+        DspKernelVariants::getAVX2()->readDelayStereo(left, right, frames, mask, writeIndex, delays, numSamples);
+    }
+
+    void renderFmAVX512(float* dest, int numSamples, DspKernels::FmState& state, float& cyclesPerSample, float glideRatio)
+    {
+        DspKernelVariants::getSSE2()->renderFm(dest, numSamples, state, cyclesPerSample, glideRatio);
+    }
+
+    const DspKernels avx512Kernels{
+        "AVX512",
+        DspKernels::Isa::AVX512,
+        renderWavetableAVX512,
+        renderWavetableMorphAVX512,
+        multiplyAVX512,
+        applyGainRampAVX512,
+        addWithGainAVX512,
+        readDelayStereoAVX512,
+        renderFmAVX512
+    };
+}
+
+const DspKernels* DspKernelVariants::getAVX512()
+{
+    return &avx512Kernels;
+}
+
+#else
+
+const DspKernels* DspKernelVariants::getAVX512()
+{
+    return nullptr;
+}
+
+#endif
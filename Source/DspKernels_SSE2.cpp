@@ -0,0 +1,297 @@
+/*
+  ==============================================================================
+
+    DspKernels_SSE2.cpp
+    Created: 19 Oct 2026 10:02:14am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if JUCE_INTEL
+
+#include <emmintrin.h>
+
+#if JUCE_GCC || JUCE_CLANG
+ #define DSP_KERNEL_TARGET __attribute__((target("sse2")))
+#else
+ #define DSP_KERNEL_TARGET
+#endif
+
+namespace
+{
+    DSP_KERNEL_TARGET void renderWavetableSSE2(float* dest, int numSamples, const float* table, int tableSize, float& phase, float phaseIncrement)
+    {
+        const auto size = _mm_set1_ps((float)tableSize);
+        const auto invSize = _mm_set1_ps(1.0f / (float)tableSize);
+        const auto step = _mm_set1_ps(4.0f * phaseIncrement);
+
+        auto p = _mm_add_ps(_mm_set1_ps(phase), _mm_mul_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(phaseIncrement)));
+        p = _mm_sub_ps(p, _mm_mul_ps(size, _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(p, invSize)))));
+
+        alignas(16) int idx[4];
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const auto index = _mm_cvttps_epi32(p);
+            const auto frac = _mm_sub_ps(p, _mm_cvtepi32_ps(index));
+            _mm_store_si128((__m128i*)idx, index);
+
+            const auto a = _mm_set_ps(table[idx[3]], table[idx[2]], table[idx[1]], table[idx[0]]);
+            const auto b = _mm_set_ps(table[idx[3] + 1], table[idx[2] + 1], table[idx[1] + 1], table[idx[0] + 1]);
+            _mm_storeu_ps(dest + i, _mm_add_ps(a, _mm_mul_ps(frac, _mm_sub_ps(b, a))));
+
+            p = _mm_add_ps(p, step);
+            p = _mm_sub_ps(p, _mm_mul_ps(size, _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(p, invSize)))));
+        }
+
+        phase = _mm_cvtss_f32(p);
+
+        if (i < numSamples)
+            DspKernelVariants::getScalar()->renderWavetable(dest + i, numSamples - i, table, tableSize, phase, phaseIncrement);
+    }
+
+    // Dos frames vecinos interpolados en x. Sin gather en SSE2: las lecturas son escalares
+    DSP_KERNEL_TARGET inline __m128 lookupFramesSSE2(const float* level, int stride, const int* frames, __m128 frameFrac, __m128 x)
+    {
+        const auto index = _mm_cvttps_epi32(x);
+        const auto frac = _mm_sub_ps(x, _mm_cvtepi32_ps(index));
+
+        alignas(16) int idx[4];
+        alignas(16) float a0[4], a1[4], b0[4], b1[4];
+        _mm_store_si128((__m128i*)idx, index);
+
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            const auto* a = level + frames[lane] * stride + idx[lane];
+            a0[lane] = a[0];
+            a1[lane] = a[1];
+            b0[lane] = a[stride];
+            b1[lane] = a[stride + 1];
+        }
+
+        const auto sampleA = _mm_add_ps(_mm_load_ps(a0), _mm_mul_ps(frac, _mm_sub_ps(_mm_load_ps(a1), _mm_load_ps(a0))));
+        const auto sampleB = _mm_add_ps(_mm_load_ps(b0), _mm_mul_ps(frac, _mm_sub_ps(_mm_load_ps(b1), _mm_load_ps(b0))));
+        return _mm_add_ps(sampleA, _mm_mul_ps(frameFrac, _mm_sub_ps(sampleB, sampleA)));
+    }
+
+    DSP_KERNEL_TARGET void renderWavetableMorphSSE2(float* dest, int numSamples, const float* levels, int frameSize, int numFrames, float levelMix,
+                                                    float& phase, float phaseIncrement, float position, float positionIncrement)
+    {
+        const auto sizeB = frameSize / 2;
+        const auto* levelB = levels + numFrames * (frameSize + 1);
+        const auto lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+        const auto sizeA = _mm_set1_ps((float)frameSize);
+        const auto sizeBv = _mm_set1_ps((float)sizeB);
+        const auto lastFrame = _mm_set1_ps((float)(numFrames - 2));
+        const auto mix = _mm_set1_ps(levelMix);
+        const auto step = _mm_set1_ps(4.0f * phaseIncrement);
+        const auto positionStep = _mm_set1_ps(4.0f * positionIncrement);
+
+        auto p = _mm_add_ps(_mm_set1_ps(phase), _mm_mul_ps(lanes, _mm_set1_ps(phaseIncrement)));
+        p = _mm_sub_ps(p, _mm_cvtepi32_ps(_mm_cvttps_epi32(p)));
+        auto framePosition = _mm_add_ps(_mm_set1_ps(position), _mm_mul_ps(lanes, _mm_set1_ps(positionIncrement)));
+
+        alignas(16) int frames[4];
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            // SSE2 no tiene minimo de enteros: el frame se limita en coma flotante
+            const auto frame = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(framePosition)), lastFrame);
+            const auto frameFrac = _mm_sub_ps(framePosition, frame);
+            _mm_store_si128((__m128i*)frames, _mm_cvttps_epi32(frame));
+
+            const auto fine = lookupFramesSSE2(levels, frameSize + 1, frames, frameFrac, _mm_mul_ps(p, sizeA));
+            const auto coarse = lookupFramesSSE2(levelB, sizeB + 1, frames, frameFrac, _mm_mul_ps(p, sizeBv));
+            _mm_storeu_ps(dest + i, _mm_add_ps(fine, _mm_mul_ps(mix, _mm_sub_ps(coarse, fine))));
+
+            p = _mm_add_ps(p, step);
+            p = _mm_sub_ps(p, _mm_cvtepi32_ps(_mm_cvttps_epi32(p)));
+            framePosition = _mm_add_ps(framePosition, positionStep);
+        }
+
+        phase = _mm_cvtss_f32(p);
+
+        if (i < numSamples)
+            DspKernelVariants::getScalar()->renderWavetableMorph(dest + i, numSamples - i, levels, frameSize, numFrames, levelMix,
+                                                                 phase, phaseIncrement, position + positionIncrement * (float)i, positionIncrement);
+    }
+
+    DSP_KERNEL_TARGET void multiplySSE2(float* dest, const float* envelope, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_loadu_ps(dest + i), _mm_loadu_ps(envelope + i)));
+
+        for (; i < numSamples; ++i)
+            dest[i] *= envelope[i];
+    }
+
+    DSP_KERNEL_TARGET void applyGainRampSSE2(float* dest, int numSamples, float startGain, float endGain)
+    {
+        const auto delta = numSamples > 0 ? (endGain - startGain) / (float)numSamples : 0.0f;
+        auto g = _mm_add_ps(_mm_set1_ps(startGain), _mm_mul_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(delta)));
+        const auto step = _mm_set1_ps(4.0f * delta);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_loadu_ps(dest + i), g));
+            g = _mm_add_ps(g, step);
+        }
+
+        for (; i < numSamples; ++i)
+            dest[i] *= startGain + delta * (float)i;
+    }
+
+    DSP_KERNEL_TARGET void addWithGainSSE2(float* dest, const float* src, int numSamples, float gain)
+    {
+        const auto g = _mm_set1_ps(gain);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+
+        for (; i < numSamples; ++i)
+            dest[i] += src[i] * gain;
+    }
+
+    DSP_KERNEL_TARGET void readDelayStereoSSE2(float* left, float* right, const float* frames, int mask, int writeIndex, const float* delays, int numSamples)
+    {
+        const auto one = _mm_set1_ps(1.0f);
+        const auto two = _mm_set1_ps(2.0f);
+        const auto half = _mm_set1_ps(0.5f);
+        const auto minusSixth = _mm_set1_ps(-1.0f / 6.0f);
+        const auto maskv = _mm_set1_epi32(mask);
+
+        alignas(16) float c0[4], c1[4], c2[4], c3[4];
+        alignas(16) int base[4];
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            // Coeficientes de cuatro muestras a la vez
+            const auto d = _mm_loadu_ps(delays + i);
+            const auto whole = _mm_cvttps_epi32(d);
+            const auto f = _mm_sub_ps(d, _mm_cvtepi32_ps(whole));
+            const auto a = _mm_sub_ps(one, f);
+            const auto b = _mm_add_ps(one, f);
+            const auto c = _mm_sub_ps(two, f);
+            const auto fb = _mm_mul_ps(f, b);
+            const auto ca = _mm_mul_ps(c, a);
+
+            _mm_store_ps(c0, _mm_mul_ps(_mm_mul_ps(a, fb), minusSixth));
+            _mm_store_ps(c1, _mm_mul_ps(_mm_mul_ps(c, fb), half));
+            _mm_store_ps(c2, _mm_mul_ps(_mm_mul_ps(ca, b), half));
+            _mm_store_ps(c3, _mm_mul_ps(_mm_mul_ps(ca, f), minusSixth));
+
+            const auto position = _mm_add_epi32(_mm_set1_epi32(writeIndex + i - 2), _mm_set_epi32(3, 2, 1, 0));
+            _mm_store_si128((__m128i*)base, _mm_and_si128(_mm_sub_epi32(position, whole), maskv));
+
+            // Cada muestra: los 4 frames (8 floats) en dos registros, L y R juntos
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                const auto* p = frames + 2 * base[lane];
+                auto s = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p), _mm_set_ps(c1[lane], c1[lane], c0[lane], c0[lane])),
+                                    _mm_mul_ps(_mm_loadu_ps(p + 4), _mm_set_ps(c3[lane], c3[lane], c2[lane], c2[lane])));
+                s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+                left[i + lane] = _mm_cvtss_f32(s);
+                right[i + lane] = _mm_cvtss_f32(_mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+            }
+        }
+
+        if (i < numSamples)
+            DspKernelVariants::getScalar()->readDelayStereo(left + i, right + i, frames, mask, writeIndex + i, delays + i, numSamples - i);
+    }
+
+    // Los 4 operadores en un registro: un carril por operador
+    DSP_KERNEL_TARGET void renderFmSSE2(float* dest, int numSamples, DspKernels::FmState& state, float& cyclesPerSample, float glideRatio)
+    {
+        const auto one = _mm_set1_ps(1.0f);
+        const auto half = _mm_set1_ps(0.5f);
+        const auto eight = _mm_set1_ps(8.0f);
+        const auto sixteen = _mm_set1_ps(16.0f);
+        const auto correction = _mm_set1_ps(0.225f);
+        const auto absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+        const auto m0 = _mm_load_ps(state.modulators[0].data());
+        const auto m1 = _mm_load_ps(state.modulators[1].data());
+        const auto m2 = _mm_load_ps(state.modulators[2].data());
+        const auto m3 = _mm_load_ps(state.modulators[3].data());
+        const auto ratios = _mm_load_ps(state.ratios.data());
+        const auto levels = _mm_load_ps(state.levels.data());
+        const auto carrierGains = _mm_load_ps(state.carrierGains.data());
+        const auto envelopeSteps = _mm_load_ps(state.envelopeSteps.data());
+
+        auto phases = _mm_load_ps(state.phases.data());
+        auto outputs = _mm_load_ps(state.outputs.data());
+        auto envelopeValues = _mm_load_ps(state.envelopeValues.data());
+        auto cycles = cyclesPerSample;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Modulacion con las salidas de la muestra anterior: columna por fuente
+            auto modulation = _mm_mul_ps(m0, _mm_shuffle_ps(outputs, outputs, _MM_SHUFFLE(0, 0, 0, 0)));
+            modulation = _mm_add_ps(modulation, _mm_mul_ps(m1, _mm_shuffle_ps(outputs, outputs, _MM_SHUFFLE(1, 1, 1, 1))));
+            modulation = _mm_add_ps(modulation, _mm_mul_ps(m2, _mm_shuffle_ps(outputs, outputs, _MM_SHUFFLE(2, 2, 2, 2))));
+            modulation = _mm_add_ps(modulation, _mm_mul_ps(m3, _mm_shuffle_ps(outputs, outputs, _MM_SHUFFLE(3, 3, 3, 3))));
+
+            phases = _mm_add_ps(phases, _mm_mul_ps(ratios, _mm_set1_ps(cycles)));
+            phases = _mm_sub_ps(phases, _mm_cvtepi32_ps(_mm_cvttps_epi32(phases)));
+            envelopeValues = _mm_add_ps(envelopeValues, envelopeSteps);
+
+            // fastSinCycles: floor a partir del truncado, corrigiendo los negativos
+            auto t = _mm_add_ps(phases, modulation);
+            const auto rounded = _mm_add_ps(t, half);
+            auto whole = _mm_cvtepi32_ps(_mm_cvttps_epi32(rounded));
+            whole = _mm_sub_ps(whole, _mm_and_ps(_mm_cmplt_ps(rounded, whole), one));
+            t = _mm_sub_ps(t, whole);
+
+            const auto y = _mm_sub_ps(_mm_mul_ps(eight, t), _mm_mul_ps(_mm_mul_ps(sixteen, t), _mm_and_ps(t, absMask)));
+            const auto sine = _mm_add_ps(_mm_mul_ps(correction, _mm_sub_ps(_mm_mul_ps(y, _mm_and_ps(y, absMask)), y)), y);
+            outputs = _mm_mul_ps(_mm_mul_ps(sine, levels), envelopeValues);
+
+            auto sum = _mm_mul_ps(outputs, carrierGains);
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            dest[i] = _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1))));
+
+            cycles *= glideRatio;
+        }
+
+        _mm_store_ps(state.phases.data(), phases);
+        _mm_store_ps(state.outputs.data(), outputs);
+        _mm_store_ps(state.envelopeValues.data(), envelopeValues);
+        cyclesPerSample = cycles;
+    }
+
+    const DspKernels sse2Kernels{
+        "SSE2",
+        DspKernels::Isa::SSE2,
+        renderWavetableSSE2,
+        renderWavetableMorphSSE2,
+        multiplySSE2,
+        applyGainRampSSE2,
+        addWithGainSSE2,
+        readDelayStereoSSE2,
+        renderFmSSE2
+    };
+}
+
+const DspKernels* DspKernelVariants::getSSE2()
+{
+    return &sse2Kernels;
+}
+
+#else
+
+const DspKernels* DspKernelVariants::getSSE2()
+{
+    return nullptr;
+}
+
+#endif
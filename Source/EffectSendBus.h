@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+	EffectSendBus.h
+	Created: 19 Oct 2026 4:31:40pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspArena.h"
+
+// Bus de envio compartido por todas las voces. Cada voz suma en el su senal
+// por el envio de su parte y el procesador lo pasa por los efectos maestros.
+class EffectSendBus {
+
+public:
+	static size_t getArenaBytesRequired(int numChannels, int maxBlockSize)
+	{
+		return DspArena::bytesForFloats(maxBlockSize) * (size_t)numChannels;
+	}
+
+	void prepare(DspArena& arena, int numChannels, int maxBlockSize)
+	{
+		std::array<float*, 2> channels{};
+		jassert(numChannels <= (int)channels.size());
+
+		for (int channel = 0; channel < numChannels; ++channel)
+			channels[(size_t)channel] = arena.allocateFloats(maxBlockSize);
+
+		buffer.setDataToReferTo(channels.data(), numChannels, maxBlockSize);
+		blockStart = 0;
+	}
+
+	// Hilo de audio: el bus cubre las muestras de la salida desde outputStartSample
+	void beginBlock(int outputStartSample, int numSamples, bool shouldBeActive) noexcept
+	{
+		jassert(numSamples <= buffer.getNumSamples());
+		blockStart = outputStartSample;
+		active = shouldBeActive;
+
+		if (active)
+			buffer.clear(0, numSamples);
+	}
+
+	bool isActive() const noexcept { return active; }
+	int getNumChannels() const noexcept { return buffer.getNumChannels(); }
+	int getMaxBlockSize() const noexcept { return buffer.getNumSamples(); }
+	juce::AudioBuffer<float>& getBuffer() noexcept { return buffer; }
+
+	float* getWritePointer(int channel, int outputSample) noexcept
+	{
+		return buffer.getWritePointer(channel, outputSample - blockStart);
+	}
+
+private:
+	juce::AudioBuffer<float> buffer;
+	int blockStart = 0;
+	bool active = false;
+
+};
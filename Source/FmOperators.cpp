@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    FmOperators.cpp
+    Created: 19 Oct 2026 7:14:36pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "FmOperators.h"
+
+namespace
+{
+    // Algoritmos: que operadores modulan a cuales y cuales suenan (bit 0 = operador 1)
+    constexpr juce::uint16 connect(int source, int destination)
+    {
+        return (juce::uint16)(1 << ((destination - 1) * FmOperators::numOperators + (source - 1)));
+    }
+
+    struct Algorithm
+    {
+        juce::uint16 connections;
+        juce::uint8 carriers;
+    };
+
+    const std::array<Algorithm, FmOperators::numAlgorithms> algorithms{ {
+        { connect(4, 3) | connect(3, 2) | connect(2, 1), 0b0001 },					// 4 > 3 > 2 > 1
+        { connect(4, 2) | connect(3, 2) | connect(2, 1), 0b0001 },					// (3 + 4) > 2 > 1
+        { connect(4, 3) | connect(3, 1) | connect(2, 1), 0b0001 },					// (2 + 4 > 3) > 1
+        { connect(4, 2) | connect(4, 3) | connect(2, 1) | connect(3, 1), 0b0001 },	// 4 > (2 + 3) > 1
+        { connect(2, 1) | connect(4, 3), 0b0101 },									// 2 > 1, 4 > 3
+        { connect(4, 1) | connect(4, 2) | connect(4, 3), 0b0111 },					// 4 > (1, 2, 3)
+        { connect(4, 3), 0b0111 },													// 4 > 3, 2, 1
+        { 0, 0b1111 }																// aditivo
+    } };
+}
+
+void FmOperators::prepare(double sampleRate)
+{
+    for (auto& envelope : envelopes)
+    {
+        envelope.setSampleRate(sampleRate / controlInterval);
+        envelope.reset();
+    }
+
+    state.phases.fill(0.0f);
+    state.outputs.fill(0.0f);
+    state.envelopeValues.fill(0.0f);
+    state.envelopeSteps.fill(0.0f);
+    controlCounter = 0;
+}
+
+void FmOperators::setSettings(const Settings& settings)
+{
+    const auto& algorithm = algorithms[(size_t)juce::jlimit(0, numAlgorithms - 1, settings.algorithm)];
+
+    for (auto& row : state.modulators)
+        row.fill(0.0f);
+
+    for (int destination = 0; destination < numOperators; ++destination)
+        for (int source = 0; source < numOperators; ++source)
+            if ((algorithm.connections >> (destination * numOperators + source)) & 1)
+                state.modulators[(size_t)source][(size_t)destination] = 1.0f;
+
+    // El operador 4 se realimenta (hasta medio ciclo de desviacion)
+    state.modulators[3][3] = 0.5f * juce::jlimit(0.0f, 1.0f, settings.feedback);
+
+    const auto numCarriers = (float)juce::countNumberOfBits((juce::uint32)algorithm.carriers);
+
+    for (int op = 0; op < numOperators; ++op)
+        state.carrierGains[(size_t)op] = ((algorithm.carriers >> op) & 1) ? 1.0f / numCarriers : 0.0f;
+
+    state.ratios = settings.ratios;
+    state.levels = settings.levels;
+
+    for (int op = 0; op < numOperators; ++op)
+        envelopes[(size_t)op].setParameters(settings.envelopes[(size_t)op]);
+}
+
+void FmOperators::noteOn()
+{
+    for (auto& envelope : envelopes)
+        envelope.noteOn();
+
+    state.phases.fill(0.0f);
+    state.outputs.fill(0.0f);
+    controlCounter = 0;
+}
+
+void FmOperators::noteOff()
+{
+    for (auto& envelope : envelopes)
+        envelope.noteOff();
+}
+
+float FmOperators::render(float* dest, int numSamples, float cyclesPerSample, float glideRatio) noexcept
+{
+    auto& kernels = DspKernels::get();
+
+    // Tramos de hasta controlInterval muestras entre dos puntos de las envolventes
+    for (int done = 0; done < numSamples;)
+    {
+        if (controlCounter == 0)
+        {
+            for (size_t op = 0; op < numOperators; ++op)
+                state.envelopeSteps[op] = (envelopes[op].getNextSample() - state.envelopeValues[op]) / (float)controlInterval;
+
+            controlCounter = controlInterval;
+        }
+
+        const int chunk = juce::jmin(controlCounter, numSamples - done);
+        kernels.renderFm(dest + done, chunk, state, cyclesPerSample, glideRatio);
+
+        controlCounter -= chunk;
+        done += chunk;
+    }
+
+    return cyclesPerSample;
+}
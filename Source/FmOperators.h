@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+	FmOperators.h
+	Created: 19 Oct 2026 7:14:36pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspKernels.h"
+
+// Motor FM (modulacion de fase) de 4 operadores para una voz. Los operadores se
+// guardan como carriles de arrays de 4 floats y cada operador se modula con la
+// salida de la muestra anterior, asi los 4 se calculan a la vez: un registro
+// SSE por muestra en DspKernels::renderFm. El seno es una aproximacion
+// polinomica, sin tablas.
+class FmOperators {
+
+public:
+	static constexpr int numOperators = 4;
+	static constexpr int numAlgorithms = 8;
+
+	struct Settings
+	{
+		int algorithm = 0;
+		float feedback = 0.0f;					// realimentacion del operador 4
+		std::array<float, numOperators> ratios{};	// multiplo de la frecuencia de la nota
+		std::array<float, numOperators> levels{};
+		std::array<juce::ADSR::Parameters, numOperators> envelopes{};
+	};
+
+	void prepare(double sampleRate);
+	void setSettings(const Settings& settings);
+	void noteOn();
+	void noteOff();
+
+	// Escribe en dest la suma de los portadores. La frecuencia base se multiplica por
+	// glideRatio en cada muestra; devuelve la frecuencia al acabar.
+	float render(float* dest, int numSamples, float cyclesPerSample, float glideRatio) noexcept;
+
+private:
+	// Las envolventes de operador van a ritmo de control con rampa lineal
+	static constexpr int controlInterval = 16;
+
+	static_assert(numOperators == 4, "DspKernels::renderFm lleva un operador por carril de 4");
+
+	DspKernels::FmState state;
+
+	std::array<juce::ADSR, numOperators> envelopes;
+	int controlCounter = 0;
+
+};
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+	KeyZone.h
+	Created: 19 Oct 2026 5:02:18pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Rango de notas y de velocidades (0-127) en el que suena un sonido.
+// Zonas que no se solapan hacen un split y las que se solapan, capas.
+struct KeyZone
+{
+	int lowNote = 0;
+	int highNote = 127;
+	int lowVelocity = 0;
+	int highVelocity = 127;
+
+	bool containsNote(int note) const noexcept { return note >= lowNote && note <= highNote; }
+	bool containsVelocity(int velocity) const noexcept { return velocity >= lowVelocity && velocity <= highVelocity; }
+};
+
+// Sonido con zona de teclado. SynthEngine la usa para construir su tabla.
+class ZonedSound : public juce::SynthesiserSound {
+
+public:
+	const KeyZone& getKeyZone() const { return keyZone; }
+
+	bool appliesToNote(int midiNoteNumber) override {
+		return keyZone.containsNote(midiNoteNumber);
+	}
+
+protected:
+	KeyZone keyZone;
+
+};
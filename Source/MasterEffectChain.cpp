@@ -0,0 +1,591 @@
+/*
+  ==============================================================================
+
+    MasterEffectChain.cpp
+    Created: 19 Oct 2026 10:05:48pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "MasterEffectChain.h"
+#include "DspKernels.h"
+
+//==============================================================================
+void ChorusStage::setParameters(float rateHz, float newDepth, float newMix)
+{
+    rate = juce::jlimit(0.01f, 10.0f, rateHz);
+    depth = juce::jlimit(0.0f, 1.0f, newDepth);
+    mix = juce::jlimit(0.0f, 1.0f, newMix);
+    parametersChanged = true;
+}
+
+void ChorusStage::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    if (parametersChanged.exchange(false))
+    {
+        chorus.setRate(rate.load());
+        chorus.setDepth(depth.load());
+        chorus.setCentreDelay(7.0f);
+        chorus.setFeedback(0.0f);
+        chorus.setMix(mix.load());
+    }
+
+    chorus.process(juce::dsp::ProcessContextReplacing<float>(block));
+}
+
+//==============================================================================
+void PhaserStage::setParameters(float rateHz, float newDepth, float newFeedback, float newMix)
+{
+    rate = juce::jlimit(0.01f, 10.0f, rateHz);
+    depth = juce::jlimit(0.0f, 1.0f, newDepth);
+    feedback = juce::jlimit(-0.95f, 0.95f, newFeedback);
+    mix = juce::jlimit(0.0f, 1.0f, newMix);
+    parametersChanged = true;
+}
+
+void PhaserStage::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    if (parametersChanged.exchange(false))
+    {
+        phaser.setRate(rate.load());
+        phaser.setDepth(depth.load());
+        phaser.setCentreFrequency(1000.0f);
+        phaser.setFeedback(feedback.load());
+        phaser.setMix(mix.load());
+    }
+
+    phaser.process(juce::dsp::ProcessContextReplacing<float>(block));
+}
+
+//==============================================================================
+int DelayStage::getNumFrames(double rate)
+{
+    // Potencia de dos: el indice circular es una mascara
+    const auto maxSamples = (maxDelaySeconds + maxModulationMs * 0.001) * rate + subBlockSize + 4;
+    return juce::nextPowerOfTwo((int)std::ceil(maxSamples));
+}
+
+size_t DelayStage::getArenaBytesRequired(double rate)
+{
+    return DspArena::bytesForFloats(2 * (getNumFrames(rate) + 3));
+}
+
+void DelayStage::allocate(DspArena& arena, double rate)
+{
+    const auto numFrames = getNumFrames(rate);
+    frames = arena.allocateFloats(2 * (numFrames + 3));
+    mask = numFrames - 1;
+}
+
+void DelayStage::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert(frames != nullptr);
+    sampleRate = spec.sampleRate;
+
+    // Los cambios de tempo o de division se deslizan (como una cinta) en vez de saltar
+    delaySamples.reset(sampleRate, 0.1);
+    reset();
+}
+
+void DelayStage::reset()
+{
+    if (frames != nullptr)
+        juce::FloatVectorOperations::clear(frames, 2 * (mask + 1 + 3));
+
+    writeIndex = 0;
+    modulationPhase = 0.0f;
+    lowPassState = {};
+    highPassState = {};
+    delaySamples.setCurrentAndTargetValue((float)(getDelaySeconds() * sampleRate));
+}
+
+void DelayStage::setParameters(int newDivision, float newFeedback, float newMix)
+{
+    division = juce::jlimit((int)Quarter, (int)Sixteenth, newDivision);
+    feedback = juce::jlimit(0.0f, 0.95f, newFeedback);
+    mix = juce::jlimit(0.0f, 1.0f, newMix);
+}
+
+void DelayStage::setFeedbackFilter(float lowCutHz, float highCutHz)
+{
+    lowCut = juce::jlimit(20.0f, 2000.0f, lowCutHz);
+    highCut = juce::jlimit(1000.0f, 20000.0f, highCutHz);
+}
+
+void DelayStage::setModulation(float rateHz, float depthMs)
+{
+    modulationRate = juce::jlimit(0.01f, 10.0f, rateHz);
+    modulationDepth = juce::jlimit(0.0f, maxModulationMs, depthMs);
+}
+
+double DelayStage::getDelaySeconds() const noexcept
+{
+    static constexpr std::array<double, 5> beats{ 1.0, 0.75, 0.5, 1.0 / 3.0, 0.25 };
+    return juce::jmin(maxDelaySeconds, beats[(size_t)division.load(std::memory_order_relaxed)] * 60.0 / bpm);
+}
+
+double DelayStage::getTailSeconds() const noexcept
+{
+    // Hasta que las repeticiones caen 80 dB
+    const auto fb = (double)feedback.load(std::memory_order_relaxed);
+    const auto repeats = fb > 0.001 ? std::log(1.0e-4) / std::log(fb) : 0.0;
+    return juce::jmin(30.0, getDelaySeconds() * (1.0 + repeats));
+}
+
+void DelayStage::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    const auto numSamples = (int)block.getNumSamples();
+    const bool stereo = block.getNumChannels() > 1;
+    auto* left = block.getChannelPointer(0);
+    auto* right = stereo ? block.getChannelPointer(1) : left;
+
+    delaySamples.setTargetValue((float)(getDelaySeconds() * sampleRate));
+
+    const auto fb = feedback.load(std::memory_order_relaxed);
+    const auto wet = mix.load(std::memory_order_relaxed);
+    const bool pingPong = mode.load(std::memory_order_relaxed) == PingPong;
+    const auto lowPassCoeff = 1.0f - std::exp(-juce::MathConstants<float>::twoPi * highCut.load(std::memory_order_relaxed) / (float)sampleRate);
+    const auto highPassCoeff = 1.0f - std::exp(-juce::MathConstants<float>::twoPi * lowCut.load(std::memory_order_relaxed) / (float)sampleRate);
+    const auto depth = modulationDepth.load(std::memory_order_relaxed) * 0.001f * (float)sampleRate;
+    const auto phaseStep = modulationRate.load(std::memory_order_relaxed) / (float)sampleRate;
+    const auto minDelay = (float)(subBlockSize + 2);
+    auto& kernels = DspKernels::get();
+
+    for (int start = 0; start < numSamples; start += subBlockSize)
+    {
+        const int num = juce::jmin(subBlockSize, numSamples - start);
+
+        for (int i = 0; i < num; ++i)
+        {
+            const auto wobble = 0.5f * (1.0f + std::sin(juce::MathConstants<float>::twoPi * modulationPhase));
+            delays[(size_t)i] = juce::jmax(minDelay, delaySamples.getNextValue() + depth * wobble);
+
+            modulationPhase += phaseStep;
+            if (modulationPhase >= 1.0f)
+                modulationPhase -= 1.0f;
+        }
+
+        kernels.readDelayStereo(wetLeft.data(), wetRight.data(), frames, mask, writeIndex, delays.data(), num);
+
+        for (int i = 0; i < num; ++i)
+        {
+            // Realimentacion filtrada: cada repeticion sale mas oscura y con menos graves
+            std::array<float, 2> echo{ wetLeft[(size_t)i], wetRight[(size_t)i] };
+
+            for (size_t channel = 0; channel < 2; ++channel)
+            {
+                lowPassState[channel] += lowPassCoeff * (echo[channel] - lowPassState[channel]);
+                highPassState[channel] += highPassCoeff * (lowPassState[channel] - highPassState[channel]);
+                echo[channel] = lowPassState[channel] - highPassState[channel];
+            }
+
+            const auto inputLeft = left[start + i];
+            const auto inputRight = right[start + i];
+
+            // Ping-pong: la entrada en mono entra por la izquierda y cada eco cambia de lado
+            const auto writeLeft = pingPong ? 0.5f * (inputLeft + inputRight) + fb * echo[1] : inputLeft + fb * echo[0];
+            const auto writeRight = pingPong ? fb * echo[0] : inputRight + fb * echo[1];
+
+            const auto index = (writeIndex + i) & mask;
+            frames[2 * index] = writeLeft;
+            frames[2 * index + 1] = writeRight;
+
+            if (index < 3)
+            {
+                frames[2 * (mask + 1 + index)] = writeLeft;
+                frames[2 * (mask + 1 + index) + 1] = writeRight;
+            }
+
+            if (stereo)
+            {
+                left[start + i] = wet * wetLeft[(size_t)i];
+                right[start + i] = wet * wetRight[(size_t)i];
+            }
+            else
+            {
+                left[start + i] = wet * 0.5f * (wetLeft[(size_t)i] + wetRight[(size_t)i]);
+            }
+        }
+
+        writeIndex = (writeIndex + num) & mask;
+    }
+}
+
+//==============================================================================
+void DistortionStage::setParameters(float driveDecibels, float newMix)
+{
+    drive = juce::jlimit(0.0f, 40.0f, driveDecibels);
+    mix = juce::jlimit(0.0f, 1.0f, newMix);
+}
+
+void DistortionStage::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    // Saturacion tanh con compensacion aproximada del volumen
+    const auto gain = juce::Decibels::decibelsToGain(drive.load(std::memory_order_relaxed));
+    const auto makeup = 1.0f / std::sqrt(gain);
+    const auto wet = mix.load(std::memory_order_relaxed);
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* data = block.getChannelPointer(channel);
+
+        for (size_t i = 0; i < block.getNumSamples(); ++i)
+        {
+            const auto x = data[i];
+            data[i] = x + wet * (std::tanh(gain * x) * makeup - x);
+        }
+    }
+}
+
+//==============================================================================
+void EqStage::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+
+    // Coeficientes de segundo orden ya reservados: luego se sobrescriben sin reservar
+    for (auto* filter : { &low, &mid, &high })
+    {
+        filter->state = new juce::dsp::IIR::Coefficients<float>(1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f);
+        filter->prepare(spec);
+    }
+
+    parametersChanged = true;
+}
+
+void EqStage::reset()
+{
+    low.reset();
+    mid.reset();
+    high.reset();
+}
+
+void EqStage::setParameters(float lowGainDecibels, float midGainDecibels, float newMidFrequency, float highGainDecibels)
+{
+    lowGain = juce::jlimit(-18.0f, 18.0f, lowGainDecibels);
+    midGain = juce::jlimit(-18.0f, 18.0f, midGainDecibels);
+    midFrequency = juce::jlimit(100.0f, 10000.0f, newMidFrequency);
+    highGain = juce::jlimit(-18.0f, 18.0f, highGainDecibels);
+    parametersChanged = true;
+}
+
+void EqStage::updateCoefficients() noexcept
+{
+    using Coefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+
+    *low.state = Coefficients::makeLowShelf(sampleRate, 200.0f, 0.707f, juce::Decibels::decibelsToGain(lowGain.load()));
+    *mid.state = Coefficients::makePeakFilter(sampleRate, midFrequency.load(), 0.7f, juce::Decibels::decibelsToGain(midGain.load()));
+    *high.state = Coefficients::makeHighShelf(sampleRate, 5000.0f, 0.707f, juce::Decibels::decibelsToGain(highGain.load()));
+}
+
+void EqStage::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    if (parametersChanged.exchange(false))
+        updateCoefficients();
+
+    juce::dsp::ProcessContextReplacing<float> context(block);
+    low.process(context);
+    mid.process(context);
+    high.process(context);
+}
+
+//==============================================================================
+void ReverbStage::setParameters(float roomSize, float damping, float wet, float dry, float width, float freeze)
+{
+    // El bus de envio solo lleva la senal humeda. La seca se escala aparte con
+    // el mismo factor (2) que aplica juce::Reverb a dryLevel.
+    juce::dsp::Reverb::Parameters params;
+    params.roomSize = roomSize;
+    params.damping = damping;
+    params.wetLevel = wet;
+    params.dryLevel = 0.0f;
+    params.width = width;
+    params.freezeMode = freeze;
+    reverb.setParameters(params);
+    dryGain = dry * 2.0f;
+}
+
+double ReverbStage::getTailSeconds() const noexcept
+{
+    // Congelada no se apaga nunca: al quitarla se corta
+    const auto& params = reverb.getParameters();
+
+    if (params.freezeMode >= 0.5f)
+        return 0.0;
+
+    // Realimentacion de los filtros peine de juce::Reverb, con unos 35 ms por vuelta
+    const auto feedback = (double)params.roomSize * 0.28 + 0.7;
+    return 0.1 + 0.035 * std::log(1.0e-4) / std::log(feedback);
+}
+
+void ReverbStage::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    if (block.getNumChannels() < 2 || ! mono.load(std::memory_order_relaxed))
+    {
+        reverb.process(juce::dsp::ProcessContextReplacing<float>(block));
+        return;
+    }
+
+    // En estereo los filtros de la izquierda ya reciben L + R: en mono siguen igual
+    auto* left = block.getChannelPointer(0);
+    auto* right = block.getChannelPointer(1);
+    const auto numSamples = (int)block.getNumSamples();
+
+    juce::FloatVectorOperations::add(left, right, numSamples);
+    auto monoBlock = block.getSingleChannelBlock(0);
+    reverb.process(juce::dsp::ProcessContextReplacing<float>(monoBlock));
+    juce::FloatVectorOperations::copy(right, left, numSamples);
+}
+
+//==============================================================================
+MasterEffectChain::MasterEffectChain()
+{
+    slots[Chorus].stage = &chorus;
+    slots[Phaser].stage = &phaser;
+    slots[Delay].stage = &delay;
+    slots[Distortion].stage = &distortion;
+    slots[Eq].stage = &eq;
+    slots[Reverb].stage = &reverb;
+
+    // Por defecto solo la reverb, como antes de tener cadena
+    plan = encode({ Chorus, Phaser, Delay, Distortion, Eq, Reverb }, 1u << Reverb);
+}
+
+juce::uint32 MasterEffectChain::encode(const Order& order, juce::uint32 enabledMask) noexcept
+{
+    juce::uint32 word = enabledMask << enabledShift;
+
+    for (int position = 0; position < numStages; ++position)
+        word |= (juce::uint32)order[(size_t)position] << (position * bitsPerStage);
+
+    return word;
+}
+
+size_t MasterEffectChain::getArenaBytesRequired(double rate, int channels, int maxBlockSize)
+{
+    return DspArena::bytesForFloats(maxBlockSize) * (size_t)channels * 2
+         + DelayStage::getArenaBytesRequired(rate);
+}
+
+void MasterEffectChain::prepare(DspArena& arena, double rate, int channels, int maxBlockSize)
+{
+    std::array<float*, 2> dry{}, wet{};
+    jassert(channels <= (int)dry.size());
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        dry[(size_t)channel] = arena.allocateFloats(maxBlockSize);
+        wet[(size_t)channel] = arena.allocateFloats(maxBlockSize);
+    }
+
+    dryScratch.setDataToReferTo(dry.data(), channels, maxBlockSize);
+    wetScratch.setDataToReferTo(wet.data(), channels, maxBlockSize);
+    sampleRate = rate;
+    numChannels = channels;
+
+    delay.allocate(arena, rate);
+
+    const juce::dsp::ProcessSpec spec{ rate, (juce::uint32)maxBlockSize, (juce::uint32)channels };
+    const auto enabledMask = plan.load() >> enabledShift;
+
+    for (int id = 0; id < numStages; ++id)
+    {
+        auto& slot = slots[(size_t)id];
+        slot.stage->prepare(spec);
+        slot.stage->reset();
+
+        // Las etapas activas empiezan sonando, sin fundido
+        slot.running = (enabledMask & (1u << id)) != 0;
+        slot.fade = slot.running ? 1.0f : 0.0f;
+        slot.tailRemaining = 0;
+    }
+}
+
+void MasterEffectChain::setOrder(const Order& newOrder)
+{
+    juce::uint32 seen = 0;
+
+    for (auto id : newOrder)
+        if (juce::isPositiveAndBelow(id, (int)numStages))
+            seen |= 1u << id;
+
+    if (seen != (1u << numStages) - 1)
+    {
+        jassertfalse;
+        return;
+    }
+
+    plan = encode(newOrder, plan.load() >> enabledShift);
+}
+
+MasterEffectChain::Order MasterEffectChain::getOrder() const
+{
+    const auto current = plan.load();
+    Order order{};
+
+    for (int position = 0; position < numStages; ++position)
+        order[(size_t)position] = (int)((current >> (position * bitsPerStage)) & 0xfu);
+
+    return order;
+}
+
+void MasterEffectChain::setStageEnabled(int stage, bool shouldBeEnabled)
+{
+    if (! juce::isPositiveAndBelow(stage, (int)numStages))
+        return;
+
+    auto enabledMask = plan.load() >> enabledShift;
+    enabledMask = shouldBeEnabled ? (enabledMask | (1u << stage)) : (enabledMask & ~(1u << stage));
+    plan = encode(getOrder(), enabledMask);
+}
+
+bool MasterEffectChain::isStageEnabled(int stage) const
+{
+    return juce::isPositiveAndBelow(stage, (int)numStages) && ((plan.load() >> (enabledShift + stage)) & 1u) != 0;
+}
+
+double MasterEffectChain::getTailSeconds() const
+{
+    const auto enabledMask = plan.load(std::memory_order_acquire) >> enabledShift;
+    double tail = 0.0;
+
+    for (int id = 0; id < numStages; ++id)
+        if ((enabledMask & (1u << id)) != 0)
+            tail = juce::jmax(tail, slots[(size_t)id].stage->getTailSeconds());
+
+    return tail;
+}
+
+bool MasterEffectChain::needsSendBus() const noexcept
+{
+    const auto enabledMask = plan.load(std::memory_order_acquire) >> enabledShift;
+
+    for (int id = 0; id < numStages; ++id)
+        if (slots[(size_t)id].stage->usesSendBus() && (slots[(size_t)id].running || (enabledMask & (1u << id)) != 0))
+            return true;
+
+    return false;
+}
+
+void MasterEffectChain::process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, EffectSendBus& sendBus) noexcept
+{
+    // El plan se lee una vez por bloque: orden y etapas activas siempre coherentes
+    const auto current = plan.load(std::memory_order_acquire);
+    const auto fadeStep = (float)((double)numSamples / (fadeSeconds * sampleRate));
+
+    for (int position = 0; position < numStages; ++position)
+    {
+        const auto id = (int)((current >> (position * bitsPerStage)) & 0xfu);
+        const bool enabled = ((current >> (enabledShift + id)) & 1u) != 0;
+        auto& slot = slots[(size_t)id];
+
+        if (! enabled && ! slot.running)
+            continue;
+
+        if (! slot.running)
+        {
+            slot.running = true;
+            slot.fade = 0.0f;
+        }
+
+        const auto fadeStart = slot.fade;
+        const auto fadeEnd = enabled ? juce::jmin(1.0f, fadeStart + fadeStep) : juce::jmax(0.0f, fadeStart - fadeStep);
+        slot.fade = fadeEnd;
+
+        if (slot.stage->isParallel())
+            processParallel(slot, buffer, startSample, numSamples, fadeStart, fadeEnd, sendBus);
+        else
+            processInsert(slot, buffer, startSample, numSamples, fadeStart, fadeEnd);
+
+        if (enabled || fadeEnd > 0.0f)
+            continue;
+
+        // Apagada del todo: las paralelas aun dejan sonar su cola
+        if (slot.stage->isParallel())
+        {
+            if (fadeStart > 0.0f)
+                slot.tailRemaining = (int)(slot.stage->getTailSeconds() * sampleRate);
+            else
+                slot.tailRemaining -= numSamples;
+
+            if (slot.tailRemaining > 0)
+                continue;
+        }
+
+        slot.running = false;
+        slot.stage->reset();
+    }
+}
+
+void MasterEffectChain::processInsert(Slot& slot, juce::AudioBuffer<float>& buffer, int startSample, int numSamples, float fadeStart, float fadeEnd) noexcept
+{
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    auto block = juce::dsp::AudioBlock<float>(buffer).getSubsetChannelBlock(0, (size_t)channels)
+                                                     .getSubBlock((size_t)startSample, (size_t)numSamples);
+
+    if (fadeStart == 1.0f && fadeEnd == 1.0f)
+    {
+        slot.stage->process(block);
+        return;
+    }
+
+    // Encendiendo o apagando: fundido entre la senal seca y la procesada
+    for (int channel = 0; channel < channels; ++channel)
+        dryScratch.copyFrom(channel, 0, buffer, channel, startSample, numSamples);
+
+    slot.stage->process(block);
+
+    auto& kernels = DspKernels::get();
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        auto* wet = buffer.getWritePointer(channel, startSample);
+        const auto* dry = dryScratch.getReadPointer(channel);
+
+        juce::FloatVectorOperations::subtract(wet, dry, numSamples);
+        kernels.applyGainRamp(wet, numSamples, fadeStart, fadeEnd);
+        juce::FloatVectorOperations::add(wet, dry, numSamples);
+    }
+}
+
+void MasterEffectChain::processParallel(Slot& slot, juce::AudioBuffer<float>& buffer, int startSample, int numSamples, float fadeStart, float fadeEnd, EffectSendBus& sendBus) noexcept
+{
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+
+    // La reverb trabaja directamente sobre el bus de envio; el resto sobre una copia
+    auto& wetBuffer = slot.stage->usesSendBus() ? sendBus.getBuffer() : wetScratch;
+    const int wetChannels = juce::jmin(channels, wetBuffer.getNumChannels());
+
+    if (! slot.stage->usesSendBus())
+        for (int channel = 0; channel < wetChannels; ++channel)
+            wetScratch.copyFrom(channel, 0, buffer, channel, startSample, numSamples);
+
+    auto& kernels = DspKernels::get();
+
+    // La entrada de la etapa sube o baja con el fundido; la cola no se toca
+    if (fadeStart == 0.0f && fadeEnd == 0.0f)
+    {
+        for (int channel = 0; channel < wetChannels; ++channel)
+            wetBuffer.clear(channel, 0, numSamples);
+    }
+    else if (fadeStart != 1.0f || fadeEnd != 1.0f)
+    {
+        for (int channel = 0; channel < wetChannels; ++channel)
+            kernels.applyGainRamp(wetBuffer.getWritePointer(channel), numSamples, fadeStart, fadeEnd);
+    }
+
+    auto wetBlock = juce::dsp::AudioBlock<float>(wetBuffer).getSubsetChannelBlock(0, (size_t)wetChannels)
+                                                          .getSubBlock(0, (size_t)numSamples);
+    slot.stage->process(wetBlock);
+
+    const auto dryGain = slot.stage->getDryGain();
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        if (dryGain != 1.0f)
+            kernels.applyGainRamp(buffer.getWritePointer(channel, startSample), numSamples,
+                                  1.0f + (dryGain - 1.0f) * fadeStart, 1.0f + (dryGain - 1.0f) * fadeEnd);
+
+        buffer.addFrom(channel, startSample, wetBuffer, juce::jmin(channel, wetChannels - 1), 0, numSamples);
+    }
+}
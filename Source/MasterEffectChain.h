@@ -0,0 +1,307 @@
+/*
+  ==============================================================================
+
+	MasterEffectChain.h
+	Created: 19 Oct 2026 10:05:48pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspArena.h"
+#include "EffectSendBus.h"
+
+// Etapa de la cadena maestra. Los parametros los escribe el hilo de mensajes y
+// la etapa los aplica al principio del siguiente bloque.
+class MasterEffectStage {
+
+public:
+	virtual ~MasterEffectStage() = default;
+
+	virtual void prepare(const juce::dsp::ProcessSpec& spec) = 0;
+	virtual void reset() = 0;
+	// Las etapas en serie procesan el bloque en sitio. Las paralelas reciben la
+	// entrada en el bloque y lo devuelven solo con la senal humeda.
+	virtual void process(juce::dsp::AudioBlock<float>& block) noexcept = 0;
+
+	virtual bool isParallel() const noexcept { return false; }
+	// Etapas paralelas: la entrada sale del bus de envio y no de la cadena
+	virtual bool usesSendBus() const noexcept { return false; }
+	// Etapas paralelas: ganancia de la senal seca que pasa por su lado
+	virtual float getDryGain() const noexcept { return 1.0f; }
+	// Segundos que sigue sonando despues de quedarse sin entrada
+	virtual double getTailSeconds() const noexcept { return 0.0; }
+
+};
+
+class ChorusStage : public MasterEffectStage {
+
+public:
+	void prepare(const juce::dsp::ProcessSpec& spec) override { chorus.prepare(spec); }
+	void reset() override { chorus.reset(); }
+	void process(juce::dsp::AudioBlock<float>& block) noexcept override;
+
+	void setParameters(float rateHz, float depth, float mix);
+	float getRate() const { return rate.load(); }
+	float getDepth() const { return depth.load(); }
+	float getMix() const { return mix.load(); }
+
+private:
+	juce::dsp::Chorus<float> chorus;
+	std::atomic<float> rate{ 0.8f }, depth{ 0.3f }, mix{ 0.5f };
+	std::atomic<bool> parametersChanged{ true };
+
+};
+
+class PhaserStage : public MasterEffectStage {
+
+public:
+	void prepare(const juce::dsp::ProcessSpec& spec) override { phaser.prepare(spec); }
+	void reset() override { phaser.reset(); }
+	void process(juce::dsp::AudioBlock<float>& block) noexcept override;
+
+	void setParameters(float rateHz, float depth, float feedback, float mix);
+	float getRate() const { return rate.load(); }
+	float getDepth() const { return depth.load(); }
+	float getFeedback() const { return feedback.load(); }
+	float getMix() const { return mix.load(); }
+
+private:
+	juce::dsp::Phaser<float> phaser;
+	std::atomic<float> rate{ 0.5f }, depth{ 0.6f }, feedback{ 0.3f }, mix{ 0.5f };
+	std::atomic<bool> parametersChanged{ true };
+
+};
+
+// Eco sincronizado con el tempo del host, estereo o ping-pong, con la
+// realimentacion filtrada y una modulacion lenta del tiempo (estilo cinta). La
+// linea es un buffer estereo intercalado que se lee con Lagrange de orden 3,
+// vectorizado sobre los dos canales (DspKernels::readDelayStereo).
+class DelayStage : public MasterEffectStage {
+
+public:
+	enum Division {
+		Quarter = 0,
+		DottedEighth,
+		Eighth,
+		TripletEighth,
+		Sixteenth
+	};
+
+	enum Mode {
+		Stereo = 0,
+		PingPong
+	};
+
+	static constexpr double maxDelaySeconds = 4.0;
+	static constexpr float maxModulationMs = 10.0f;
+	// Se lee un trozo entero antes de escribirlo: el retardo nunca baja de aqui
+	static constexpr int subBlockSize = 32;
+
+	static size_t getArenaBytesRequired(double sampleRate);
+	// Antes de prepare: la linea sale del arena del procesador, ya con el tamano maximo
+	void allocate(DspArena& arena, double sampleRate);
+
+	void prepare(const juce::dsp::ProcessSpec& spec) override;
+	void reset() override;
+	void process(juce::dsp::AudioBlock<float>& block) noexcept override;
+	bool isParallel() const noexcept override { return true; }
+	double getTailSeconds() const noexcept override;
+
+	void setParameters(int division, float feedback, float mix);
+	int getDivision() const { return division.load(); }
+	float getFeedback() const { return feedback.load(); }
+	float getMix() const { return mix.load(); }
+	void setMode(int newMode) { mode = juce::jlimit((int)Stereo, (int)PingPong, newMode); }
+	int getMode() const { return mode.load(); }
+	// Paso alto y paso bajo de un polo en la realimentacion, en Hz
+	void setFeedbackFilter(float lowCutHz, float highCutHz);
+	float getLowCut() const { return lowCut.load(); }
+	float getHighCut() const { return highCut.load(); }
+	// Modulacion del tiempo: velocidad en Hz y profundidad en ms
+	void setModulation(float rateHz, float depthMs);
+	float getModulationRate() const { return modulationRate.load(); }
+	float getModulationDepth() const { return modulationDepth.load(); }
+
+	// Hilo de audio, una vez por bloque del host. El cambio de tiempo se desliza.
+	void setTempo(double newBpm) noexcept { bpm = newBpm; }
+
+private:
+	static int getNumFrames(double sampleRate);
+	double getDelaySeconds() const noexcept;
+
+	float* frames = nullptr;	// L, R intercalados; mask + 1 frames y 3 de guarda
+	int mask = 0;
+	int writeIndex = 0;
+
+	alignas(32) std::array<float, subBlockSize> delays{};
+	alignas(32) std::array<float, subBlockSize> wetLeft{};
+	alignas(32) std::array<float, subBlockSize> wetRight{};
+
+	juce::SmoothedValue<float> delaySamples;
+	float modulationPhase = 0.0f;
+	std::array<float, 2> lowPassState{}, highPassState{};
+	double sampleRate = 44100.0;
+	double bpm = 120.0;
+
+	std::atomic<int> division{ Eighth };
+	std::atomic<int> mode{ Stereo };
+	std::atomic<float> feedback{ 0.35f }, mix{ 0.3f };
+	std::atomic<float> lowCut{ 80.0f }, highCut{ 6000.0f };
+	std::atomic<float> modulationRate{ 0.4f }, modulationDepth{ 1.0f };
+
+};
+
+class DistortionStage : public MasterEffectStage {
+
+public:
+	void prepare(const juce::dsp::ProcessSpec&) override {}
+	void reset() override {}
+	void process(juce::dsp::AudioBlock<float>& block) noexcept override;
+
+	void setParameters(float driveDecibels, float mix);
+	float getDrive() const { return drive.load(); }
+	float getMix() const { return mix.load(); }
+
+private:
+	std::atomic<float> drive{ 4.0f }, mix{ 1.0f };
+
+};
+
+// Ecualizador de tres bandas: graves y agudos en estanteria y un pico en medios
+class EqStage : public MasterEffectStage {
+
+public:
+	void prepare(const juce::dsp::ProcessSpec& spec) override;
+	void reset() override;
+	void process(juce::dsp::AudioBlock<float>& block) noexcept override;
+
+	void setParameters(float lowGainDecibels, float midGainDecibels, float midFrequency, float highGainDecibels);
+	float getLowGain() const { return lowGain.load(); }
+	float getMidGain() const { return midGain.load(); }
+	float getMidFrequency() const { return midFrequency.load(); }
+	float getHighGain() const { return highGain.load(); }
+
+private:
+	using Filter = juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>>;
+
+	void updateCoefficients() noexcept;
+
+	Filter low, mid, high;
+	double sampleRate = 44100.0;
+	std::atomic<float> lowGain{ 0.0f }, midGain{ 0.0f }, midFrequency{ 1000.0f }, highGain{ 0.0f };
+	std::atomic<bool> parametersChanged{ true };
+
+};
+
+// La reverb maestra de siempre: se alimenta del bus de envio de las voces y
+// suma su retorno en el punto de la cadena donde este
+class ReverbStage : public MasterEffectStage {
+
+public:
+	void prepare(const juce::dsp::ProcessSpec& spec) override { reverb.prepare(spec); }
+	void reset() override { reverb.reset(); }
+	void process(juce::dsp::AudioBlock<float>& block) noexcept override;
+	bool isParallel() const noexcept override { return true; }
+	bool usesSendBus() const noexcept override { return true; }
+	float getDryGain() const noexcept override { return dryGain.load(std::memory_order_relaxed); }
+	double getTailSeconds() const noexcept override;
+
+	void setParameters(float roomSize, float damping, float wet, float dry, float width, float freeze);
+	// Calidad reducida: la entrada se suma a mono y solo trabaja un banco de filtros
+	void setMono(bool shouldBeMono) { mono = shouldBeMono; }
+
+private:
+	juce::dsp::Reverb reverb;
+	std::atomic<float> dryGain{ 1.0f };
+	std::atomic<bool> mono{ false };
+
+};
+
+// Cadena de efectos maestra con orden configurable. El orden y las etapas
+// activas van codificados en un solo entero que el hilo de mensajes prepara y
+// publica de golpe; el hilo de audio solo lo lee. Las etapas apagadas no se
+// procesan en absoluto. Al apagar una etapa en serie se funde con la senal
+// seca; una paralela deja de recibir entrada y sigue hasta acabar su cola.
+class MasterEffectChain {
+
+public:
+	enum StageId {
+		Chorus = 0,
+		Phaser,
+		Delay,
+		Distortion,
+		Eq,
+		Reverb,
+		numStages
+	};
+
+	using Order = std::array<int, numStages>;
+
+	static constexpr double fadeSeconds = 0.02;
+
+	MasterEffectChain();
+
+	static size_t getArenaBytesRequired(double sampleRate, int numChannels, int maxBlockSize);
+	void prepare(DspArena& arena, double sampleRate, int numChannels, int maxBlockSize);
+
+	// Hilo de mensajes. El orden tiene que ser una permutacion de las etapas.
+	void setOrder(const Order& newOrder);
+	Order getOrder() const;
+	void setStageEnabled(int stage, bool shouldBeEnabled);
+	bool isStageEnabled(int stage) const;
+	// La cola mas larga entre las etapas activas, para getTailLengthSeconds
+	double getTailSeconds() const;
+
+	ChorusStage& getChorus() { return chorus; }
+	PhaserStage& getPhaser() { return phaser; }
+	DelayStage& getDelay() { return delay; }
+	DistortionStage& getDistortion() { return distortion; }
+	EqStage& getEq() { return eq; }
+	ReverbStage& getReverb() { return reverb; }
+
+	// Hilo de audio
+	void setTempo(double bpm) noexcept { delay.setTempo(bpm); }
+	// Si alguna etapa que suena necesita el bus de envio (la reverb)
+	bool needsSendBus() const noexcept;
+	void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, EffectSendBus& sendBus) noexcept;
+
+private:
+	// Estado de cada etapa visto desde el hilo de audio
+	struct Slot
+	{
+		MasterEffectStage* stage = nullptr;
+		bool running = false;
+		float fade = 0.0f;			// 0 = fuera, 1 = sonando del todo
+		int tailRemaining = 0;
+	};
+
+	static constexpr int bitsPerStage = 4;
+	static constexpr int enabledShift = numStages * bitsPerStage;
+
+	static juce::uint32 encode(const Order& order, juce::uint32 enabledMask) noexcept;
+
+	void processInsert(Slot& slot, juce::AudioBuffer<float>& buffer, int startSample, int numSamples, float fadeStart, float fadeEnd) noexcept;
+	void processParallel(Slot& slot, juce::AudioBuffer<float>& buffer, int startSample, int numSamples, float fadeStart, float fadeEnd, EffectSendBus& sendBus) noexcept;
+
+	ChorusStage chorus;
+	PhaserStage phaser;
+	DelayStage delay;
+	DistortionStage distortion;
+	EqStage eq;
+	ReverbStage reverb;
+
+	std::array<Slot, numStages> slots;
+	std::atomic<juce::uint32> plan{ 0 };
+
+	double sampleRate = 44100.0;
+	int numChannels = 0;
+
+	// Buffers repartidos desde el arena del procesador
+	juce::AudioBuffer<float> dryScratch, wetScratch;
+
+	JUCE_DECLARE_NON_COPYABLE(MasterEffectChain)
+};
@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+    MasterLimiter.cpp
+    Created: 19 Oct 2026 9:26:13pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "MasterLimiter.h"
+
+MasterLimiter::MasterLimiter()
+{
+    // Paso bajo en sinc con ventana Blackman al Nyquist de entrada, repartido en
+    // fases; cada fase tiene ganancia 1 en continua. Con un numero impar de
+    // coeficientes una de las fases cae justo en las muestras originales.
+    constexpr int numTaps = oversampling * tapsPerPhase - 1;
+    const auto centre = (double)(numTaps - 1) * 0.5;
+
+    for (int i = 0; i < numTaps; ++i)
+    {
+        const auto x = ((double)i - centre) / (double)oversampling;
+        const auto sinc = x == 0.0 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+        const auto w = juce::MathConstants<double>::twoPi * (double)i / (double)(numTaps - 1);
+        const auto window = 0.42 - 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w);
+        phaseTaps[(size_t)(i % oversampling)][(size_t)(i / oversampling)] = (float)(sinc * window);
+    }
+
+    for (auto& taps : phaseTaps)
+    {
+        float sum = 0.0f;
+        for (auto t : taps)
+            sum += t;
+
+        for (auto& t : taps)
+            t /= sum;
+    }
+}
+
+size_t MasterLimiter::getArenaBytesRequired(int channels, int blockSize, double rate)
+{
+    const auto lookaheadSize = getLookaheadSamples(rate);
+
+    return (DspArena::bytesForFloats(tapsPerPhase - 1 + blockSize)
+            + DspArena::bytesForFloats(getLatencySamples(rate) + blockSize)) * (size_t)channels
+         + DspArena::bytesForFloats(blockSize) * 3
+         + DspArena::bytesForFloats(lookaheadSize - 1 + blockSize) * 4;
+}
+
+void MasterLimiter::prepare(DspArena& arena, int channels, int blockSize, double rate)
+{
+    jassert(channels <= (int)inputHistory.size());
+
+    sampleRate = rate;
+    numChannels = channels;
+    maxBlockSize = blockSize;
+    lookahead = getLookaheadSamples(rate);
+    latency = getLatencySamples(rate);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        inputHistory[(size_t)channel] = arena.allocateFloats(tapsPerPhase - 1 + blockSize);
+        delayLines[(size_t)channel] = arena.allocateFloats(latency + blockSize);
+    }
+
+    phaseScratch = arena.allocateFloats(blockSize);
+    heldPeaks = arena.allocateFloats(blockSize);
+    gains = arena.allocateFloats(blockSize);
+    peakHistory = arena.allocateFloats(lookahead - 1 + blockSize);
+    envelopeHistory = arena.allocateFloats(lookahead - 1 + blockSize);
+
+    for (auto& scratch : windowScratch)
+        scratch = arena.allocateFloats(lookahead - 1 + blockSize);
+
+    reset();
+    needsReset = false;
+}
+
+void MasterLimiter::reset() noexcept
+{
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        juce::FloatVectorOperations::clear(inputHistory[(size_t)channel], tapsPerPhase - 1);
+        juce::FloatVectorOperations::clear(delayLines[(size_t)channel], latency);
+    }
+
+    // Los picos son valores absolutos: 0 hace de menos infinito
+    juce::FloatVectorOperations::clear(peakHistory, lookahead - 1);
+    juce::FloatVectorOperations::fill(envelopeHistory, 1.0f, lookahead - 1);
+    envelope = 1.0f;
+}
+
+void MasterLimiter::setEnabled(bool shouldBeEnabled)
+{
+    if (shouldBeEnabled && ! enabled.load())
+        needsReset = true;
+
+    enabled = shouldBeEnabled;
+}
+
+void MasterLimiter::setCeilingDecibels(float decibels)
+{
+    ceiling = juce::Decibels::decibelsToGain(juce::jlimit(-24.0f, 0.0f, decibels));
+}
+
+void MasterLimiter::setReleaseSeconds(float seconds)
+{
+    releaseSeconds = juce::jlimit(0.001f, 2.0f, seconds);
+}
+
+template <typename Combine>
+void MasterLimiter::combineWindow(float* dest, const float* history, int numSamples, Combine combine) noexcept
+{
+    // level[j] combina las width muestras que acaban en j (solo vale para j >= width - 1).
+    // Cada paso dobla width con una operacion vectorial sobre todo el bloque, y la
+    // ventana se arma con los niveles de las potencias de 2 que suman lookahead:
+    // log2(lookahead) pasadas en lugar de un bucle muestra a muestra.
+    const int total = lookahead - 1 + numSamples;
+    const float* level = history;
+    int next = 0;
+    int offset = 0;
+    bool first = true;
+
+    for (int width = 1, remaining = lookahead; remaining > 0; width *= 2)
+    {
+        if ((remaining & width) != 0)
+        {
+            // Trozo de width muestras que acaba offset muestras antes de cada salida
+            const float* part = level + lookahead - 1 - offset;
+
+            if (first)
+                juce::FloatVectorOperations::copy(dest, part, numSamples);
+            else
+                combine(dest, dest, part, numSamples);
+
+            first = false;
+            offset += width;
+            remaining -= width;
+        }
+
+        if (remaining == 0)
+            break;
+
+        auto* doubled = windowScratch[(size_t)next];
+        combine(doubled + width, level + width, level, total - width);
+        level = doubled;
+        next ^= 1;
+    }
+}
+
+void MasterLimiter::process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    jassert(numSamples <= maxBlockSize);
+
+    if (needsReset.exchange(false))
+        reset();
+
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    const int historySize = tapsPerPhase - 1;
+
+    // Pico entre muestras de todos los canales: cada fase es una convolucion corta
+    // sobre el bloque entero, con operaciones vectoriales
+    auto* peaks = peakHistory + lookahead - 1;
+    juce::FloatVectorOperations::clear(peaks, numSamples);
+    const bool detectTruePeak = truePeak.load(std::memory_order_relaxed);
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        auto* history = inputHistory[(size_t)channel];
+        juce::FloatVectorOperations::copy(history + historySize, buffer.getReadPointer(channel, startSample), numSamples);
+
+        if (detectTruePeak)
+        {
+            for (const auto& taps : phaseTaps)
+            {
+                juce::FloatVectorOperations::clear(phaseScratch, numSamples);
+
+                for (int k = 0; k < tapsPerPhase; ++k)
+                    juce::FloatVectorOperations::addWithMultiply(phaseScratch, history + historySize - k, taps[(size_t)k], numSamples);
+
+                juce::FloatVectorOperations::abs(phaseScratch, phaseScratch, numSamples);
+                juce::FloatVectorOperations::max(peaks, peaks, phaseScratch, numSamples);
+            }
+        }
+        else
+        {
+            juce::FloatVectorOperations::abs(phaseScratch, history + historySize - (firDelay - 1), numSamples);
+            juce::FloatVectorOperations::max(peaks, peaks, phaseScratch, numSamples);
+        }
+
+        std::memmove(history, history + numSamples, sizeof(float) * (size_t)historySize);
+    }
+
+    const auto limit = ceiling.load(std::memory_order_relaxed);
+    const auto releaseCoeff = 1.0f - std::exp(-1.0f / (releaseSeconds.load(std::memory_order_relaxed) * (float)sampleRate));
+    auto* envelopes = envelopeHistory + lookahead - 1;
+
+    combineWindow(heldPeaks, peakHistory, numSamples, [](float* dest, const float* a, const float* b, int num) {
+        juce::FloatVectorOperations::max(dest, a, b, num);
+        });
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto held = heldPeaks[i];
+        const auto target = held > limit ? limit / held : 1.0f;
+
+        // Baja al instante (la media movil hace de ataque) y sube con el release
+        envelope = target < envelope ? target : envelope + (target - envelope) * releaseCoeff;
+        envelopes[i] = envelope;
+    }
+
+    combineWindow(gains, envelopeHistory, numSamples, [](float* dest, const float* a, const float* b, int num) {
+        juce::FloatVectorOperations::add(dest, a, b, num);
+        });
+    juce::FloatVectorOperations::multiply(gains, 1.0f / (float)lookahead, numSamples);
+
+    std::memmove(peakHistory, peakHistory + numSamples, sizeof(float) * (size_t)(lookahead - 1));
+    std::memmove(envelopeHistory, envelopeHistory + numSamples, sizeof(float) * (size_t)(lookahead - 1));
+    const auto minGain = numSamples > 0 ? juce::jmin(1.0f, juce::FloatVectorOperations::findMinimum(gains, numSamples)) : 1.0f;
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        auto* delay = delayLines[(size_t)channel];
+        auto* output = buffer.getWritePointer(channel, startSample);
+
+        juce::FloatVectorOperations::copy(delay + latency, output, numSamples);
+        juce::FloatVectorOperations::multiply(output, delay, gains, numSamples);
+        std::memmove(delay, delay + numSamples, sizeof(float) * (size_t)latency);
+    }
+
+    gainReduction.store(juce::Decibels::gainToDecibels(minGain), std::memory_order_relaxed);
+}
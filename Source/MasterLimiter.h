@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+	MasterLimiter.h
+	Created: 19 Oct 2026 9:26:13pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspArena.h"
+
+// Limitador con anticipacion para la salida maestra. Los picos se detectan
+// entre muestras (true peak) interpolando x4 con un FIR polifasico; el maximo
+// de la ventana de anticipacion y la media movil de la ganancia (de la misma
+// longitud, asi llega al valor necesario justo cuando el pico sale por el
+// retardo) se calculan para el bloque entero con operaciones vectoriales.
+// Solo el seguidor de envolvente, que es recursivo, va muestra a muestra.
+class MasterLimiter {
+
+public:
+	static constexpr int oversampling = 4;
+	static constexpr int tapsPerPhase = 12;
+	static constexpr double lookaheadSeconds = 0.0015;
+
+	MasterLimiter();
+
+	static int getLookaheadSamples(double sampleRate) { return juce::jmax(1, juce::roundToInt(lookaheadSeconds * sampleRate)); }
+	// Latencia total: anticipacion mas el retardo del interpolador
+	static int getLatencySamples(double sampleRate) { return getLookaheadSamples(sampleRate) + firDelay - 1; }
+	static size_t getArenaBytesRequired(int numChannels, int maxBlockSize, double sampleRate);
+
+	void prepare(DspArena& arena, int numChannels, int maxBlockSize, double sampleRate);
+	// Hilo de audio. numSamples no puede superar el tamano de bloque de prepare.
+	void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+
+	// Desactivado no cuesta nada: el procesador ni lo llama y reporta latencia 0.
+	// Al volver a activarlo se vacian los retardos antes del siguiente bloque.
+	void setEnabled(bool shouldBeEnabled);
+	bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+	void setCeilingDecibels(float decibels);
+	float getCeilingDecibels() const { return juce::Decibels::gainToDecibels(ceiling.load()); }
+	void setReleaseSeconds(float seconds);
+	float getReleaseSeconds() const { return releaseSeconds.load(); }
+
+	// Sin deteccion true peak solo se miran las muestras (con el mismo retardo que
+	// la fase central del interpolador): mucho mas barato, puede pasarse un poco
+	void setTruePeakDetection(bool shouldDetectTruePeak) { truePeak = shouldDetectTruePeak; }
+	bool getTruePeakDetection() const noexcept { return truePeak.load(std::memory_order_relaxed); }
+
+	// Reduccion de ganancia maxima del ultimo bloque, para medidores
+	float getGainReductionDecibels() const { return gainReduction.load(std::memory_order_relaxed); }
+
+private:
+	// Muestras de entrada que tarda un pico (tambien entre muestras) en llegar al detector
+	static constexpr int firDelay = (oversampling * tapsPerPhase) / (2 * oversampling);
+
+	void reset() noexcept;
+	// Maximo o suma de las ultimas lookahead muestras para cada muestra del bloque.
+	// history tiene lookahead - 1 muestras anteriores delante del bloque.
+	template <typename Combine>
+	void combineWindow(float* dest, const float* history, int numSamples, Combine combine) noexcept;
+
+	// phaseTaps[p][k]: coeficiente k de la fase p del interpolador
+	std::array<std::array<float, tapsPerPhase>, oversampling> phaseTaps{};
+
+	std::atomic<bool> enabled{ true };
+	std::atomic<bool> needsReset{ true };
+	std::atomic<bool> truePeak{ true };
+	std::atomic<float> ceiling{ 0.891f };
+	std::atomic<float> releaseSeconds{ 0.1f };
+	std::atomic<float> gainReduction{ 0.0f };
+
+	double sampleRate = 44100.0;
+	int numChannels = 0;
+	int maxBlockSize = 0;
+	int lookahead = 1;
+	int latency = 0;
+
+	// Buffers repartidos desde el arena del procesador
+	std::array<float*, 2> inputHistory{};	// tapsPerPhase - 1 muestras anteriores + bloque
+	std::array<float*, 2> delayLines{};		// latencia + bloque
+	float* phaseScratch = nullptr;
+	float* heldPeaks = nullptr;
+	float* gains = nullptr;
+	float* peakHistory = nullptr;			// lookahead - 1 picos anteriores + bloque
+	float* envelopeHistory = nullptr;		// lookahead - 1 envolventes anteriores + bloque
+	std::array<float*, 2> windowScratch{};	// niveles intermedios de combineWindow
+
+	float envelope = 1.0f;
+
+};
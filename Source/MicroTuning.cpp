@@ -0,0 +1,306 @@
+/*
+  ==============================================================================
+
+    MicroTuning.cpp
+    Created: 19 Oct 2026 6:20:51pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "MicroTuning.h"
+
+namespace
+{
+    // Lineas de un fichero Scala sin los comentarios ('!')
+    juce::StringArray getScalaLines(const juce::String& text)
+    {
+        juce::StringArray lines;
+
+        for (auto& line : juce::StringArray::fromLines(text))
+            if (! line.trimStart().startsWithChar('!'))
+                lines.add(line.trim());
+
+        return lines;
+    }
+
+    int floorDiv(int a, int b) noexcept
+    {
+        return a >= 0 ? a / b : -((-a + b - 1) / b);
+    }
+}
+
+MicroTuning::MicroTuning()
+{
+    equalTemperament = sharedResources->getRateTables(sampleRate);
+    increments.store(equalTemperament->noteIncrements.data());
+}
+
+MicroTuning::~MicroTuning()
+{
+    loader.removeAllJobs(true, 2000);
+}
+
+bool MicroTuning::parseScale(const juce::String& text, Scale& scale, juce::String& error)
+{
+    auto lines = getScalaLines(text);
+
+    if (lines.size() < 2)
+    {
+        error = "Fichero .scl incompleto";
+        return false;
+    }
+
+    scale.description = lines[0];
+    scale.cents.clearQuick();
+
+    const int numNotes = lines[1].getIntValue();
+
+    if (numNotes <= 0 || lines.size() < 2 + numNotes)
+    {
+        error = "Numero de notas no valido en el .scl";
+        return false;
+    }
+
+    for (int i = 0; i < numNotes; ++i)
+    {
+        // Solo cuenta el primer campo; lo demas es comentario
+        const auto value = lines[2 + i].upToFirstOccurrenceOf(" ", false, false)
+                                       .upToFirstOccurrenceOf("\t", false, false);
+
+        if (value.containsChar('.'))
+        {
+            scale.cents.add(value.getDoubleValue());
+        }
+        else
+        {
+            const auto numerator = value.upToFirstOccurrenceOf("/", false, false).getDoubleValue();
+            const auto denominator = value.containsChar('/') ? value.fromFirstOccurrenceOf("/", false, false).getDoubleValue() : 1.0;
+
+            if (numerator <= 0.0 || denominator <= 0.0)
+            {
+                error = "Grado no valido en el .scl: " + value;
+                return false;
+            }
+
+            scale.cents.add(1200.0 * std::log2(numerator / denominator));
+        }
+    }
+
+    return true;
+}
+
+bool MicroTuning::parseKeyboardMapping(const juce::String& text, KeyboardMapping& mapping, juce::String& error)
+{
+    auto lines = getScalaLines(text);
+
+    if (lines.size() < 7)
+    {
+        error = "Fichero .kbm incompleto";
+        return false;
+    }
+
+    const int mapSize = lines[0].getIntValue();
+    mapping.firstNote = juce::jlimit(0, 127, lines[1].getIntValue());
+    mapping.lastNote = juce::jlimit(0, 127, lines[2].getIntValue());
+    mapping.middleNote = lines[3].getIntValue();
+    mapping.referenceNote = juce::jlimit(0, 127, lines[4].getIntValue());
+    mapping.referenceFrequency = lines[5].getDoubleValue();
+    mapping.octaveDegree = lines[6].getIntValue();
+    mapping.degrees.clearQuick();
+
+    if (mapSize < 0 || mapping.referenceFrequency <= 0.0)
+    {
+        error = "Cabecera no valida en el .kbm";
+        return false;
+    }
+
+    // Las entradas que faltan al final del mapa cuentan como teclas sin asignar
+    for (int i = 0; i < mapSize; ++i)
+    {
+        const auto entry = lines[7 + i];
+        mapping.degrees.add(entry.isEmpty() || entry.startsWithIgnoreCase("x") ? -1 : entry.getIntValue());
+    }
+
+    return true;
+}
+
+std::array<double, 128> MicroTuning::computeFrequencies(const Scale& scale, const KeyboardMapping& mapping)
+{
+    std::array<double, 128> frequencies{};
+    const int numDegrees = scale.cents.size();
+
+    if (numDegrees == 0)
+        return frequencies;
+
+    const int mapSize = mapping.degrees.size();
+    const int octaveDegree = mapping.octaveDegree > 0 ? mapping.octaveDegree : numDegrees;
+    const double periodCents = scale.cents.getLast();
+
+    // Grado de la escala de cada tecla; false si la tecla no esta asignada
+    auto getDegree = [&](int note, int& degree) {
+        const int offset = note - mapping.middleNote;
+
+        if (mapSize == 0)
+        {
+            degree = offset;
+            return true;
+        }
+
+        const int repeat = floorDiv(offset, mapSize);
+        const int entry = mapping.degrees.getUnchecked(offset - repeat * mapSize);
+
+        if (entry < 0)
+            return false;
+
+        degree = entry + repeat * octaveDegree;
+        return true;
+        };
+
+    auto getCents = [&](int degree) {
+        const int period = floorDiv(degree, numDegrees);
+        const int step = degree - period * numDegrees;
+        return period * periodCents + (step == 0 ? 0.0 : scale.cents.getUnchecked(step - 1));
+        };
+
+    int referenceDegree = 0;
+
+    if (! getDegree(mapping.referenceNote, referenceDegree))
+        referenceDegree = mapping.referenceNote - mapping.middleNote;
+
+    const double referenceCents = getCents(referenceDegree);
+
+    for (int note = mapping.firstNote; note <= mapping.lastNote; ++note)
+    {
+        int degree = 0;
+
+        if (getDegree(note, degree))
+            frequencies[(size_t)note] = mapping.referenceFrequency * std::pow(2.0, (getCents(degree) - referenceCents) / 1200.0);
+    }
+
+    return frequencies;
+}
+
+void MicroTuning::prepare(double newSampleRate)
+{
+    const juce::ScopedLock sl(tableLock);
+
+    sampleRate = newSampleRate;
+    equalTemperament = sharedResources->getRateTables(sampleRate);
+
+    // prepareToPlay no coincide con el hilo de audio: se puede recalcular en sitio
+    if (current != nullptr)
+    {
+        computeIncrements(*current);
+        increments.store(current->increments.data());
+    }
+    else
+    {
+        increments.store(equalTemperament->noteIncrements.data());
+    }
+}
+
+void MicroTuning::loadScala(const juce::String& sclText, const juce::String& kbmText, bool synchronous)
+{
+    if (! synchronous)
+    {
+        loader.addJob([this, sclText, kbmText]() { parseAndPublish(sclText, kbmText); });
+        return;
+    }
+
+    // Una carga anterior aun en el hilo no puede publicar despues de esta
+    loader.removeAllJobs(true, 2000);
+    parseAndPublish(sclText, kbmText);
+}
+
+void MicroTuning::parseAndPublish(const juce::String& sclText, const juce::String& kbmText)
+{
+    Scale scale;
+    KeyboardMapping mapping;
+    juce::String error;
+
+    if (! parseScale(sclText, scale, error)
+        || (kbmText.isNotEmpty() && ! parseKeyboardMapping(kbmText, mapping, error)))
+    {
+        const juce::ScopedLock sl(tableLock);
+        lastError = error;
+        return;
+    }
+
+    auto table = std::make_unique<Table>();
+    table->frequencies = computeFrequencies(scale, mapping);
+    table->sclText = sclText;
+    table->kbmText = kbmText;
+    table->description = scale.description;
+    publish(std::move(table));
+}
+
+void MicroTuning::loadScalaFiles(const juce::File& sclFile, const juce::File& kbmFile)
+{
+    loader.addJob([this, sclFile, kbmFile]() {
+        loadScala(sclFile.loadFileAsString(), kbmFile.existsAsFile() ? kbmFile.loadFileAsString() : juce::String());
+        });
+}
+
+void MicroTuning::resetToEqualTemperament()
+{
+    // Igual que una carga sincrona: lo pendiente no puede pisar el 12-TET
+    loader.removeAllJobs(true, 2000);
+    publish(nullptr);
+}
+
+void MicroTuning::publish(std::unique_ptr<Table> table)
+{
+    const juce::ScopedLock sl(tableLock);
+
+    if (table != nullptr)
+    {
+        computeIncrements(*table);
+        increments.store(table->increments.data(), std::memory_order_seq_cst);
+    }
+    else
+    {
+        increments.store(equalTemperament->noteIncrements.data(), std::memory_order_seq_cst);
+    }
+
+    if (current != nullptr)
+        retired.push_back(std::move(current));
+
+    current = std::move(table);
+    lastError.clear();
+
+    // Un lector que aun tenga una tabla retirada ya estaba contado antes del
+    // cambio de puntero; si no hay ninguno se pueden liberar todas
+    if (readers.load(std::memory_order_seq_cst) == 0)
+        retired.clear();
+}
+
+void MicroTuning::computeIncrements(Table& table) const
+{
+    for (size_t note = 0; note < 128; ++note)
+        table.increments[note] = (float)(table.frequencies[note] * SharedDspResources::waveformTableSize / sampleRate);
+}
+
+juce::String MicroTuning::getScalaText() const
+{
+    const juce::ScopedLock sl(tableLock);
+    return current != nullptr ? current->sclText : juce::String();
+}
+
+juce::String MicroTuning::getKeyboardMappingText() const
+{
+    const juce::ScopedLock sl(tableLock);
+    return current != nullptr ? current->kbmText : juce::String();
+}
+
+juce::String MicroTuning::getDescription() const
+{
+    const juce::ScopedLock sl(tableLock);
+    return current != nullptr ? current->description : juce::String("12-TET");
+}
+
+juce::String MicroTuning::getLastError() const
+{
+    const juce::ScopedLock sl(tableLock);
+    return lastError;
+}
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+	MicroTuning.h
+	Created: 19 Oct 2026 6:20:51pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SharedDspResources.h"
+
+// Afinacion de las voces: una tabla de 128 incrementos de fase (uno por nota
+// MIDI). Por defecto es la tabla 12-TET compartida; los ficheros Scala (.scl y
+// .kbm) se leen en un hilo aparte y la tabla nueva se publica con un puntero
+// atomico, asi que el note-on solo hace una consulta.
+class MicroTuning {
+
+public:
+	// Escala .scl: cents de cada grado respecto al grado 0. El ultimo es el periodo.
+	struct Scale
+	{
+		juce::String description;
+		juce::Array<double> cents;
+	};
+
+	// Mapa de teclado .kbm. Un tamano 0 asigna grados consecutivos a teclas consecutivas.
+	struct KeyboardMapping
+	{
+		int firstNote = 0;
+		int lastNote = 127;
+		int middleNote = 60;
+		int referenceNote = 69;
+		double referenceFrequency = 440.0;
+		int octaveDegree = 0;		// 0 = el numero de grados de la escala
+		juce::Array<int> degrees;	// -1 = tecla sin asignar
+	};
+
+	MicroTuning();
+	~MicroTuning();
+
+	static bool parseScale(const juce::String& text, Scale& scale, juce::String& error);
+	static bool parseKeyboardMapping(const juce::String& text, KeyboardMapping& mapping, juce::String& error);
+	// Frecuencia en Hz de cada nota MIDI; 0 para las teclas sin asignar
+	static std::array<double, 128> computeFrequencies(const Scale& scale, const KeyboardMapping& mapping);
+
+	// Hilo de mensajes. Con synchronous la tabla se publica antes de volver (render
+	// offline y reproduccion de capturas) y se descartan las cargas pendientes.
+	void prepare(double sampleRate);
+	void loadScala(const juce::String& sclText, const juce::String& kbmText = {}, bool synchronous = false);
+	void loadScalaFiles(const juce::File& sclFile, const juce::File& kbmFile = {});
+	void resetToEqualTemperament();
+	juce::String getScalaText() const;
+	juce::String getKeyboardMappingText() const;
+	juce::String getDescription() const;
+	juce::String getLastError() const;
+
+	// Hilo de audio. 0 si la tecla no suena en esta afinacion.
+	float getNoteIncrement(int midiNoteNumber) const noexcept
+	{
+		// Mientras haya lectores publish no libera ninguna tabla retirada
+		readers.fetch_add(1, std::memory_order_seq_cst);
+		const auto increment = increments.load(std::memory_order_seq_cst)[midiNoteNumber];
+		readers.fetch_sub(1, std::memory_order_release);
+		return increment;
+	}
+
+private:
+	struct Table
+	{
+		std::array<double, 128> frequencies{};
+		std::array<float, 128> increments{};
+		juce::String sclText, kbmText, description;
+	};
+
+	void parseAndPublish(const juce::String& sclText, const juce::String& kbmText);
+	void publish(std::unique_ptr<Table> table);
+	void computeIncrements(Table& table) const;
+
+	juce::SharedResourcePointer<SharedDspResources> sharedResources;
+	std::shared_ptr<const SharedDspResources::RateTables> equalTemperament;
+	double sampleRate = 44100.0;
+
+	// Las tablas sustituidas se guardan hasta una publicacion sin lectores en
+	// curso: el hilo de audio puede haber cogido el puntero justo antes del cambio
+	mutable juce::CriticalSection tableLock;
+	std::unique_ptr<Table> current;
+	std::vector<std::unique_ptr<Table>> retired;
+	juce::String lastError;
+	std::atomic<const float*> increments{ nullptr };
+	mutable std::atomic<int> readers{ 0 };
+
+	juce::ThreadPool loader{ 1 };
+
+	JUCE_DECLARE_NON_COPYABLE(MicroTuning)
+};
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    NoiseGenerator.cpp
+    Created: 19 Oct 2026 8:47:05pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "NoiseGenerator.h"
+
+void NoiseGenerator::setSeed(juce::uint32 seed) noexcept
+{
+    // Mezclar la semilla por carril para que no empiecen correlados (xorshift no admite 0)
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto z = seed + 0x9e3779b9u * (juce::uint32)(lane + 1);
+        z = (z ^ (z >> 16)) * 0x85ebca6bu;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+        z ^= z >> 16;
+        state[(size_t)lane] = z != 0 ? z : 1u;
+    }
+
+    pendingIndex = numLanes;
+    pinkState.fill(0.0f);
+    brownState = 0.0f;
+}
+
+void NoiseGenerator::generateLanes(float* dest) noexcept
+{
+    // Sin dependencias entre carriles: el compilador lo convierte en operaciones SIMD
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto x = state[(size_t)lane];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state[(size_t)lane] = x;
+        dest[lane] = (float)(juce::int32)x * (1.0f / 2147483648.0f);
+    }
+}
+
+void NoiseGenerator::fillWhite(float* dest, int numSamples) noexcept
+{
+    int i = 0;
+
+    while (i < numSamples && pendingIndex < numLanes)
+        dest[i++] = pending[(size_t)pendingIndex++];
+
+    for (; i + numLanes <= numSamples; i += numLanes)
+        generateLanes(dest + i);
+
+    if (i < numSamples)
+    {
+        generateLanes(pending.data());
+        pendingIndex = 0;
+
+        while (i < numSamples)
+            dest[i++] = pending[(size_t)pendingIndex++];
+    }
+}
+
+void NoiseGenerator::fill(float* dest, int numSamples) noexcept
+{
+    fillWhite(dest, numSamples);
+
+    if (type == Pink)
+    {
+        auto& b = pinkState;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto white = dest[i];
+            b[0] = 0.99886f * b[0] + white * 0.0555179f;
+            b[1] = 0.99332f * b[1] + white * 0.0750759f;
+            b[2] = 0.96900f * b[2] + white * 0.1538520f;
+            b[3] = 0.86650f * b[3] + white * 0.3104856f;
+            b[4] = 0.55000f * b[4] + white * 0.5329522f;
+            b[5] = -0.7616f * b[5] - white * 0.0168980f;
+            dest[i] = (b[0] + b[1] + b[2] + b[3] + b[4] + b[5] + b[6] + white * 0.5362f) * 0.11f;
+            b[6] = white * 0.115926f;
+        }
+    }
+    else if (type == Brown)
+    {
+        auto brown = brownState;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            brown = (brown + 0.02f * dest[i]) * (1.0f / 1.02f);
+            dest[i] = brown * 3.5f;
+        }
+
+        brownState = brown;
+    }
+}
+
+float NoiseGenerator::next() noexcept
+{
+    float sample;
+    fill(&sample, 1);
+    return sample;
+}
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+	NoiseGenerator.h
+	Created: 19 Oct 2026 8:47:05pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Ruido blanco, rosa y marron. El blanco sale de 8 generadores xorshift32 en
+// carriles paralelos que se avanzan a la vez (SIMD entre carriles), asi un
+// bloque entero se rellena de golpe. Con la misma semilla la secuencia es
+// siempre la misma, para que los renders offline sean reproducibles.
+class NoiseGenerator {
+
+public:
+	enum Type {
+		White = 0,
+		Pink,
+		Brown
+	};
+
+	static constexpr int numLanes = 8;
+
+	NoiseGenerator() { setSeed(0); }
+
+	void setSeed(juce::uint32 seed) noexcept;
+	void setType(int newType) noexcept { type = (Type)juce::jlimit(0, 2, newType); }
+
+	// Como oscilador: un bloque de ruido en [-1, 1]
+	void fill(float* dest, int numSamples) noexcept;
+	// Como fuente de modulacion a ritmo de control: una sola muestra
+	float next() noexcept;
+
+private:
+	void fillWhite(float* dest, int numSamples) noexcept;
+	void generateLanes(float* dest) noexcept;
+
+	alignas(32) std::array<juce::uint32, numLanes> state{};
+	// Muestras blancas ya generadas que aun no se han usado
+	alignas(32) std::array<float, numLanes> pending{};
+	int pendingIndex = numLanes;
+
+	Type type = White;
+
+	// Filtro de rosa de Paul Kellett e integrador con fugas para el marron
+	std::array<float, 7> pinkState{};
+	float brownState = 0.0f;
+
+};
@@ -1,16 +1,55 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+//==============================================================================
+SharedEditorResources::SharedEditorResources()
+    : trashHandTypeface(juce::Typeface::createSystemTypefaceFor(BinaryData::TrashHand_TTF, BinaryData::TrashHand_TTFSize))
+{
+    // === ESTILO VERDE CHILLN ===
+    juce::Colour neonGreen = juce::Colours::limegreen;
+
+    neonLookAndFeel.setColour(juce::Slider::thumbColourId, neonGreen);
+    neonLookAndFeel.setColour(juce::Slider::trackColourId, neonGreen);
+    neonLookAndFeel.setColour(juce::Slider::rotarySliderFillColourId, neonGreen);
+    neonLookAndFeel.setColour(juce::Label::textColourId, neonGreen);
+    neonLookAndFeel.setColour(juce::ToggleButton::textColourId, neonGreen);
+    neonLookAndFeel.setColour(juce::ComboBox::textColourId, neonGreen);
+    neonLookAndFeel.setColour(juce::ComboBox::outlineColourId, neonGreen);
+}
+
 //==============================================================================
 SynthAudioProcessorEditor::SynthAudioProcessorEditor(SynthAudioProcessor& p)
     : AudioProcessorEditor(&p), audioProcessor(p)
 {
-    setSize(620, 500); 
-    
-    auto typeface = juce::Typeface::createSystemTypefaceFor(BinaryData::TrashHand_TTF, BinaryData::TrashHand_TTFSize);
-    customFont = juce::Font(typeface).withHeight(24.0f);
-    customFont.setHeight(24.0f);
-    // Tamao aumentado para caber todos los controles cmodamente
+    customFont = juce::Font(juce::FontOptions(sharedResources->trashHandTypeface).withHeight(24.0f));
+
+    // Todos los controles se colocan una vez en el tamao de diseo y
+    // al redimensionar solo se escala el contenido
+    content.setLookAndFeel(&sharedResources->neonLookAndFeel);
+    content.setBounds(0, 0, designWidth, designHeight);
+    addAndMakeVisible(content);
+
+    setOpaque(true);
+    setResizable(true, true);
+    setResizeLimits(designWidth / 2, designHeight / 2, designWidth * 2, designHeight * 2);
+    getConstrainer()->setFixedAspectRatio((double)designWidth / (double)designHeight);
+    setSize(designWidth, designHeight);
+
+    // Los controles se construyen despues de abrir la ventana, asi el primer
+    // repintado (fondo y titulo cacheados) no espera por ellos
+    juce::Component::SafePointer<SynthAudioProcessorEditor> safeThis(this);
+    juce::MessageManager::callAsync([safeThis]() {
+        if (safeThis != nullptr)
+            safeThis->buildControls();
+        });
+}
+
+void SynthAudioProcessorEditor::buildControls()
+{
+    if (controlsBuilt)
+        return;
+
+    controlsBuilt = true;
 
     // ==== VOLUMEN ====
     volumeSlider.setSliderStyle(juce::Slider::LinearHorizontal);
@@ -18,18 +57,78 @@ SynthAudioProcessorEditor::SynthAudioProcessorEditor(SynthAudioProcessor& p)
     volumeSlider.setRange(0.0, 1.0, 0.01);
     volumeSlider.setValue(audioProcessor.getCurrentVolume());
     volumeSlider.addListener(this);
-    addAndMakeVisible(volumeSlider);
+    content.addAndMakeVisible(volumeSlider);
 
     // ==== WAVEFORM SELECTOR ====
     waveformSelector.addItem("Sine", 1);
     waveformSelector.addItem("Square", 2);
     waveformSelector.addItem("Saw", 3);
     waveformSelector.addItem("Triangle", 4);
+    waveformSelector.addItem("FM", 5);
+    waveformSelector.addItem("Wavetable", 6);
+    waveformSelector.addItem("White Noise", 7);
+    waveformSelector.addItem("Pink Noise", 8);
+    waveformSelector.addItem("Brown Noise", 9);
     waveformSelector.setSelectedId(audioProcessor.getCurrentWaveform() + 1);
     waveformSelector.onChange = [this]() {
         audioProcessor.setCurrentWaveform(waveformSelector.getSelectedId() - 1);
+        refreshPartControls();
+        };
+    content.addAndMakeVisible(waveformSelector);
+
+    // ==== TABLA CON MORPHING ====
+    wavetableSelector.addItemList({ "Basic", "Pulse", "Harmonics" }, 1);
+    wavetableSelector.setSelectedId(audioProcessor.getCurrentWavetable() + 1, juce::dontSendNotification);
+    wavetableSelector.onChange = [this]() {
+        audioProcessor.setCurrentWavetable(wavetableSelector.getSelectedId() - 1);
+        };
+    content.addAndMakeVisible(wavetableSelector);
+
+    wavetablePositionSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    wavetablePositionSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    wavetablePositionSlider.setRange(0.0, 1.0, 0.01);
+    wavetablePositionSlider.setValue(audioProcessor.getCurrentWavetablePosition());
+    wavetablePositionSlider.addListener(this);
+    content.addAndMakeVisible(wavetablePositionSlider);
+
+    wavetableSelector.setEnabled(audioProcessor.getCurrentWaveform() == 5);
+    wavetablePositionSlider.setEnabled(audioProcessor.getCurrentWaveform() == 5);
+
+    // ==== PARTES (MULTITIMBRAL) ====
+    for (int i = 0; i < SynthAudioProcessor::numParts; ++i)
+        partSelector.addItem("Parte " + juce::String(i + 1), i + 1);
+    partSelector.setSelectedId(audioProcessor.getEditedPart() + 1, juce::dontSendNotification);
+    partSelector.setEnabled(audioProcessor.isMultitimbral());
+    partSelector.onChange = [this]() {
+        audioProcessor.setEditedPart(partSelector.getSelectedId() - 1);
+        refreshPartControls();
+        };
+    content.addAndMakeVisible(partSelector);
+
+    multitimbralToggleButton.setToggleState(audioProcessor.isMultitimbral(), juce::dontSendNotification);
+    multitimbralToggleButton.onClick = [this]() {
+        audioProcessor.setMultitimbral(multitimbralToggleButton.getToggleState());
+        partSelector.setEnabled(audioProcessor.isMultitimbral());
+        partSelector.setSelectedId(audioProcessor.getEditedPart() + 1, juce::dontSendNotification);
+        refreshPartControls();
         };
-    addAndMakeVisible(waveformSelector);
+    content.addAndMakeVisible(multitimbralToggleButton);
+
+    // ==== ARPEGIADOR ====
+    auto& arpeggiator = audioProcessor.getArpeggiator();
+    arpModeSelector.addItemList({ "Arp Off", "Up", "Down", "Up/Down", "Random", "Sequencer" }, 1);
+    arpModeSelector.setSelectedId(arpeggiator.getMode() + 1, juce::dontSendNotification);
+    arpModeSelector.onChange = [this]() {
+        audioProcessor.setArpeggiatorMode(arpModeSelector.getSelectedId() - 1);
+        };
+    content.addAndMakeVisible(arpModeSelector);
+
+    arpRateSelector.addItemList({ "1/4", "1/8", "1/16", "1/32", "1/64" }, 1);
+    arpRateSelector.setSelectedId(arpeggiator.getRate() + 1, juce::dontSendNotification);
+    arpRateSelector.onChange = [this]() {
+        audioProcessor.setArpeggiatorRate(arpRateSelector.getSelectedId() - 1);
+        };
+    content.addAndMakeVisible(arpRateSelector);
 
     // ==== ADSR SLIDERS ====
     auto configureADSRSlider = [](juce::Slider& slider, juce::Label& label, const juce::String& name, float min, float max, float init) {
@@ -48,12 +147,25 @@ SynthAudioProcessorEditor::SynthAudioProcessorEditor(SynthAudioProcessor& p)
 
     for (auto* s : { &attackSlider, &decaySlider, &sustainSlider, &releaseSlider }) {
         s->addListener(this);
-        addAndMakeVisible(*s);
+        content.addAndMakeVisible(*s);
     }
 
     for (auto* l : { &attackLabel, &decayLabel, &sustainLabel, &releaseLabel }) {
-        addAndMakeVisible(*l);
+        content.addAndMakeVisible(*l);
     }
+
+    // ==== MODO DE REPRODUCCION Y PORTAMENTO ====
+    playModeSelector.addItemList({ "Poly", "Poly Glide", "Mono", "Legato" }, 1);
+    playModeSelector.setSelectedId(audioProcessor.getPlayMode() + 1, juce::dontSendNotification);
+    playModeSelector.onChange = [this]() {
+        audioProcessor.setPlayMode(playModeSelector.getSelectedId() - 1);
+        };
+    content.addAndMakeVisible(playModeSelector);
+
+    configureADSRSlider(glideSlider, glideLabel, "Glide", 0.0f, 2.0f, audioProcessor.getGlideTime());
+    glideSlider.addListener(this);
+    content.addAndMakeVisible(glideSlider);
+    content.addAndMakeVisible(glideLabel);
     // ==== REVERB SLIDERS ====
     auto configureReverbSlider = [](juce::Slider& slider, juce::Label& label, const juce::String& name, float min, float max, float init) {
         slider.setSliderStyle(juce::Slider::Rotary);
@@ -64,6 +176,7 @@ SynthAudioProcessorEditor::SynthAudioProcessorEditor(SynthAudioProcessor& p)
         label.setJustificationType(juce::Justification::centred);
         };
 
+    configureReverbSlider(reverbSendSlider, reverbSendLabel, "Send", 0.0f, 1.0f, audioProcessor.getCurrentReverbSend());
     configureReverbSlider(reverbRoomSlider, reverbRoomLabel, "Room Size", 0.0f, 1.0f, audioProcessor.getCurrentRoomSize());
     configureReverbSlider(reverbDampingSlider, reverbDampingLabel, "Damping", 0.0f, 1.0f, audioProcessor.getCurrentDamping());
     configureReverbSlider(reverbWetSlider, reverbWetLabel, "Wet Level", 0.0f, 1.0f, audioProcessor.getCurrentWetLevel());
@@ -71,112 +184,301 @@ SynthAudioProcessorEditor::SynthAudioProcessorEditor(SynthAudioProcessor& p)
     configureReverbSlider(reverbWidthSlider, reverbWidthLabel, "Width", 0.0f, 1.0f, audioProcessor.getCurrentWidth());
     configureReverbSlider(reverbFreezeSlider, reverbFreezeLabel, "Freeze", 0.0f, 1.0f, audioProcessor.getCurrentFreeze());
 
-    for (auto* s : { &reverbRoomSlider, &reverbDampingSlider, &reverbWetSlider, &reverbDrySlider, &reverbWidthSlider, &reverbFreezeSlider }) {
+    for (auto* s : { &reverbSendSlider, &reverbRoomSlider, &reverbDampingSlider, &reverbWetSlider, &reverbDrySlider, &reverbWidthSlider, &reverbFreezeSlider }) {
         s->addListener(this);
-        addAndMakeVisible(*s);
+        content.addAndMakeVisible(*s);
     }
 
-    for (auto* l : { &reverbRoomLabel, &reverbDampingLabel, &reverbWetLabel, &reverbDryLabel, &reverbWidthLabel, &reverbFreezeLabel }) {
-        addAndMakeVisible(*l);
+    for (auto* l : { &reverbSendLabel, &reverbRoomLabel, &reverbDampingLabel, &reverbWetLabel, &reverbDryLabel, &reverbWidthLabel, &reverbFreezeLabel }) {
+        content.addAndMakeVisible(*l);
     }
 
-    addAndMakeVisible(reverbToggleButton);
+    content.addAndMakeVisible(reverbToggleButton);
     reverbToggleButton.setToggleState(audioProcessor.getReverbEnabled(), juce::dontSendNotification);
     reverbToggleButton.onClick = [this]() {
         bool isOn = reverbToggleButton.getToggleState();
         audioProcessor.setReverbEnabled(isOn);
         };
 
-    // === ESTILO VERDE CHILLN ===
-    juce::Colour neonGreen = juce::Colours::limegreen;
-
-    auto setSliderGreenStyle = [neonGreen](juce::Slider& slider) {
-        slider.setColour(juce::Slider::thumbColourId, neonGreen);
-        slider.setColour(juce::Slider::trackColourId, neonGreen);
-        slider.setColour(juce::Slider::rotarySliderFillColourId, neonGreen);
+    // ==== LIMITADOR ====
+    limiterToggleButton.setToggleState(audioProcessor.getLimiter().isEnabled(), juce::dontSendNotification);
+    limiterToggleButton.onClick = [this]() {
+        audioProcessor.setLimiterEnabled(limiterToggleButton.getToggleState());
         };
+    content.addAndMakeVisible(limiterToggleButton);
 
-    auto setLabelGreenStyle = [neonGreen](juce::Label& label) {
-        label.setColour(juce::Label::textColourId, neonGreen);
+    governorToggleButton.setToggleState(audioProcessor.getQualityGovernor().isEnabled(), juce::dontSendNotification);
+    governorToggleButton.onClick = [this]() {
+        audioProcessor.setQualityGovernorEnabled(governorToggleButton.getToggleState());
+        };
+    content.addAndMakeVisible(governorToggleButton);
+    qualityTierLabel.setJustificationType(juce::Justification::centredLeft);
+    content.addAndMakeVisible(qualityTierLabel);
+    timerCallback();
+    startTimerHz(4);
+
+    // ==== FM ====
+    fmAlgorithmSelector.addItemList({ "4>3>2>1", "(3+4)>2>1", "(2+4>3)>1", "4>(2+3)>1", "2>1, 4>3", "4>(1,2,3)", "4>3, 2, 1", "Aditivo" }, 1);
+    fmAlgorithmSelector.setSelectedId(audioProcessor.getCurrentFmAlgorithm() + 1, juce::dontSendNotification);
+    fmAlgorithmSelector.onChange = [this]() {
+        audioProcessor.setCurrentFmAlgorithm(fmAlgorithmSelector.getSelectedId() - 1);
         };
+    content.addAndMakeVisible(fmAlgorithmSelector);
+
+    for (int op = 0; op < FmOperators::numOperators; ++op)
+        fmOperatorSelector.addItem("Operador " + juce::String(op + 1), op + 1);
+    fmOperatorSelector.setSelectedId(1, juce::dontSendNotification);
+    fmOperatorSelector.onChange = [this]() { refreshFmOperatorControls(); };
+    content.addAndMakeVisible(fmOperatorSelector);
+
+    configureADSRSlider(fmFeedbackSlider, fmFeedbackLabel, "Feedback", 0.0f, 1.0f, audioProcessor.getCurrentFmFeedback());
+    configureADSRSlider(fmRatioSlider, fmRatioLabel, "Ratio", 0.125f, 32.0f, 1.0f);
+    configureADSRSlider(fmLevelSlider, fmLevelLabel, "Level", 0.0f, 1.0f, 0.0f);
+    configureADSRSlider(fmAttackSlider, fmAttackLabel, "Attack", 0.001f, 5.0f, 0.01f);
+    configureADSRSlider(fmDecaySlider, fmDecayLabel, "Decay", 0.001f, 5.0f, 0.3f);
+    configureADSRSlider(fmSustainSlider, fmSustainLabel, "Sustain", 0.0f, 1.0f, 0.7f);
+    configureADSRSlider(fmReleaseSlider, fmReleaseLabel, "Release", 0.001f, 5.0f, 0.5f);
+    fmRatioSlider.setSkewFactorFromMidPoint(2.0);
+    refreshFmOperatorControls();
+
+    for (auto* s : { &fmFeedbackSlider, &fmRatioSlider, &fmLevelSlider, &fmAttackSlider, &fmDecaySlider, &fmSustainSlider, &fmReleaseSlider }) {
+        s->addListener(this);
+        s->setEnabled(audioProcessor.getCurrentWaveform() == 4);
+        content.addAndMakeVisible(*s);
+    }
+
+    for (auto* l : { &fmFeedbackLabel, &fmRatioLabel, &fmLevelLabel, &fmAttackLabel, &fmDecayLabel, &fmSustainLabel, &fmReleaseLabel }) {
+        content.addAndMakeVisible(*l);
+    }
+
+    fmAlgorithmSelector.setEnabled(audioProcessor.getCurrentWaveform() == 4);
+    fmOperatorSelector.setEnabled(audioProcessor.getCurrentWaveform() == 4);
 
-    reverbToggleButton.setColour(juce::ToggleButton::textColourId, neonGreen);
-    waveformSelector.setColour(juce::ComboBox::textColourId, neonGreen);
-    waveformSelector.setColour(juce::ComboBox::outlineColourId, neonGreen);
+    // ==== PANORAMA ====
+    configureADSRSlider(panSlider, panLabel, "Pan", -1.0f, 1.0f, audioProcessor.getCurrentPan());
+    configureADSRSlider(panKeyTrackingSlider, panKeyTrackingLabel, "Key Pan", -1.0f, 1.0f, audioProcessor.getCurrentPanKeyTracking());
+    configureADSRSlider(panSpreadSlider, panSpreadLabel, "Spread", 0.0f, 1.0f, audioProcessor.getCurrentPanSpread());
 
-    for (auto* s : { &attackSlider, &decaySlider, &sustainSlider, &releaseSlider,
-                     &reverbRoomSlider, &reverbDampingSlider, &reverbWetSlider,
-                     &reverbDrySlider, &reverbWidthSlider, &reverbFreezeSlider, &volumeSlider }) {
-        setSliderGreenStyle(*s);
+    for (auto* s : { &panSlider, &panKeyTrackingSlider, &panSpreadSlider }) {
+        s->addListener(this);
+        content.addAndMakeVisible(*s);
     }
 
-    for (auto* l : { &attackLabel, &decayLabel, &sustainLabel, &releaseLabel,
-                     &reverbRoomLabel, &reverbDampingLabel, &reverbWetLabel,
-                     &reverbDryLabel, &reverbWidthLabel, &reverbFreezeLabel }) {
-        setLabelGreenStyle(*l);
+    for (auto* l : { &panLabel, &panKeyTrackingLabel, &panSpreadLabel }) {
+        content.addAndMakeVisible(*l);
     }
-    addAndMakeVisible(waveformTitleLabel);
-    addAndMakeVisible(adsrTitleLabel);
-    addAndMakeVisible(reverbTitleLabel);
 
+    // ==== CAPTURA DE SESION ====
+    captureToggleButton.setToggleState(audioProcessor.getSessionCapture().isCapturing(), juce::dontSendNotification);
+    captureToggleButton.onClick = [this]() {
+        auto& capture = audioProcessor.getSessionCapture();
+
+        if (! captureToggleButton.getToggleState())
+        {
+            capture.stop();
+            return;
+        }
+
+        const auto file = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                              .getChildFile("SynthCaptures")
+                              .getChildFile("captura-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".scap");
+
+        if (! capture.start(file))
+            captureToggleButton.setToggleState(false, juce::dontSendNotification);
+        };
+    content.addAndMakeVisible(captureToggleButton);
+
+    // ==== AFINACION ====
+    tuningButton.setButtonText("Afinacion: " + audioProcessor.getTuning().getDescription());
+    tuningButton.onClick = [this]() { chooseTuningFile(); };
+    content.addAndMakeVisible(tuningButton);
+
+    // Ttulos: el texto y la fuente no cambian, se fijan una sola vez
+    waveformTitleLabel.setText("Controles de Volumen y Forma de Onda", juce::dontSendNotification);
+    waveformTitleLabel.setFont(customFont);
+    adsrTitleLabel.setText("Controles ADSR", juce::dontSendNotification);
+    reverbTitleLabel.setText("Controles de Reverb", juce::dontSendNotification);
+    fmTitleLabel.setText("Controles FM y Panorama", juce::dontSendNotification);
+
+    for (auto* l : { &waveformTitleLabel, &adsrTitleLabel, &reverbTitleLabel, &fmTitleLabel }) {
+        l->setColour(juce::Label::textColourId, juce::Colours::white);
+        l->setJustificationType(juce::Justification::centred);
+        l->setBufferedToImage(true);
+        content.addAndMakeVisible(*l);
+    }
+
+    analyser = std::make_unique<AnalyserComponent>(audioProcessor);
+    content.addAndMakeVisible(*analyser);
+
+    layoutContent();
+}
+
+void SynthAudioProcessorEditor::chooseTuningFile()
+{
+    tuningChooser = std::make_unique<juce::FileChooser>("Escala Scala", juce::File(), "*.scl");
+
+    tuningChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+        [this](const juce::FileChooser& chooser) {
+            const auto file = chooser.getResult();
+
+            if (file == juce::File())
+                return;
+
+            // Si junto a la escala hay un .kbm con el mismo nombre se usa como mapa de teclado
+            audioProcessor.loadTuningFiles(file, file.withFileExtension("kbm"));
+            tuningButton.setButtonText("Afinacion: " + file.getFileNameWithoutExtension());
+        });
+}
+
+void SynthAudioProcessorEditor::refreshPartControls()
+{
+    // Mostrar los valores de la parte seleccionada sin volver a enviarlos
+    volumeSlider.setValue(audioProcessor.getCurrentVolume(), juce::dontSendNotification);
+    waveformSelector.setSelectedId(audioProcessor.getCurrentWaveform() + 1, juce::dontSendNotification);
+    attackSlider.setValue(audioProcessor.getCurrentAttack(), juce::dontSendNotification);
+    decaySlider.setValue(audioProcessor.getCurrentDecay(), juce::dontSendNotification);
+    sustainSlider.setValue(audioProcessor.getCurrentSustain(), juce::dontSendNotification);
+    releaseSlider.setValue(audioProcessor.getCurrentRelease(), juce::dontSendNotification);
+    reverbSendSlider.setValue(audioProcessor.getCurrentReverbSend(), juce::dontSendNotification);
+    wavetableSelector.setSelectedId(audioProcessor.getCurrentWavetable() + 1, juce::dontSendNotification);
+    wavetablePositionSlider.setValue(audioProcessor.getCurrentWavetablePosition(), juce::dontSendNotification);
+
+    const bool isWavetable = audioProcessor.getCurrentWaveform() == 5;
+    wavetableSelector.setEnabled(isWavetable);
+    wavetablePositionSlider.setEnabled(isWavetable);
+
+    panSlider.setValue(audioProcessor.getCurrentPan(), juce::dontSendNotification);
+    panKeyTrackingSlider.setValue(audioProcessor.getCurrentPanKeyTracking(), juce::dontSendNotification);
+    panSpreadSlider.setValue(audioProcessor.getCurrentPanSpread(), juce::dontSendNotification);
+
+    fmAlgorithmSelector.setSelectedId(audioProcessor.getCurrentFmAlgorithm() + 1, juce::dontSendNotification);
+    fmFeedbackSlider.setValue(audioProcessor.getCurrentFmFeedback(), juce::dontSendNotification);
+    refreshFmOperatorControls();
+
+    const bool isFm = audioProcessor.getCurrentWaveform() == 4;
+    for (auto* c : std::initializer_list<juce::Component*>{ &fmAlgorithmSelector, &fmOperatorSelector, &fmFeedbackSlider, &fmRatioSlider,
+                                                            &fmLevelSlider, &fmAttackSlider, &fmDecaySlider, &fmSustainSlider, &fmReleaseSlider })
+        c->setEnabled(isFm);
+}
+
+void SynthAudioProcessorEditor::refreshFmOperatorControls()
+{
+    const auto& fmOperator = audioProcessor.getCurrentFmOperator(fmOperatorSelector.getSelectedId() - 1);
+    fmRatioSlider.setValue(fmOperator.ratio.load(), juce::dontSendNotification);
+    fmLevelSlider.setValue(fmOperator.level.load(), juce::dontSendNotification);
+    fmAttackSlider.setValue(fmOperator.attack.load(), juce::dontSendNotification);
+    fmDecaySlider.setValue(fmOperator.decay.load(), juce::dontSendNotification);
+    fmSustainSlider.setValue(fmOperator.sustain.load(), juce::dontSendNotification);
+    fmReleaseSlider.setValue(fmOperator.release.load(), juce::dontSendNotification);
 }
 
 //==============================================================================
-SynthAudioProcessorEditor::~SynthAudioProcessorEditor() {}
+SynthAudioProcessorEditor::~SynthAudioProcessorEditor()
+{
+    stopTimer();
+    content.setLookAndFeel(nullptr);
+}
+
+void SynthAudioProcessorEditor::timerCallback()
+{
+    const auto& governor = audioProcessor.getQualityGovernor();
+    qualityTierLabel.setText(juce::String(QualityGovernor::getTierName(governor.getTier()))
+                             + " (" + juce::String(juce::roundToInt(governor.getLoad() * 100.0f)) + "%)",
+                             juce::dontSendNotification);
+}
 
 void SynthAudioProcessorEditor::paint(juce::Graphics& g)
 {
+    paintStartTicks = juce::Time::getHighResolutionTicks();
+
+    if (openToFirstPaintMs < 0.0)
+    {
+        openToFirstPaintMs = juce::Time::highResolutionTicksToSeconds(paintStartTicks - openTicks) * 1000.0;
+
+        if (onFirstPaint)
+            onFirstPaint(openToFirstPaintMs);
+    }
+
+    // El fondo y el ttulo son estticos: se dibujan desde la imagen cacheada
+    g.drawImage(backgroundCache, getLocalBounds().toFloat());
+}
+
+void SynthAudioProcessorEditor::paintOverChildren(juce::Graphics&)
+{
+    const auto elapsedMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - paintStartTicks) * 1000.0;
+
+    paintStats.lastFrameMs = elapsedMs;
+    paintStats.averageFrameMs = paintStats.numFrames == 0 ? elapsedMs : paintStats.averageFrameMs * 0.9 + elapsedMs * 0.1;
+    paintStats.maxFrameMs = juce::jmax(paintStats.maxFrameMs, elapsedMs);
+    ++paintStats.numFrames;
+}
+
+void SynthAudioProcessorEditor::resized()
+{
+    const auto scale = (float)getWidth() / (float)designWidth;
+    content.setTransform(juce::AffineTransform::scale(scale));
+
+    renderBackground();
+}
+
+void SynthAudioProcessorEditor::renderBackground()
+{
+    const auto pixelScale = juce::jmax(1.0f, juce::Component::getApproximateScaleFactorForComponent(this));
+    const auto scale = (float)getWidth() / (float)designWidth;
+
+    backgroundCache = juce::Image(juce::Image::RGB,
+                                  juce::jmax(1, juce::roundToInt((float)getWidth() * pixelScale)),
+                                  juce::jmax(1, juce::roundToInt((float)getHeight() * pixelScale)),
+                                  false);
+
+    juce::Graphics g(backgroundCache);
+    g.addTransform(juce::AffineTransform::scale(pixelScale * scale));
+
     g.fillAll(juce::Colours::black);
 
     g.setColour(juce::Colours::white);
-    g.setFont(juce::Font("Arial", 24.0f, juce::Font::bold));  // Ms grande y con estilo
+    g.setFont(titleFont);  // Ms grande y con estilo
 
-    juce::Rectangle<int> titleArea = getLocalBounds().withTop(15).withHeight(40); // Margen superior de 15
+    juce::Rectangle<int> titleArea = juce::Rectangle<int>(0, 0, designWidth, designHeight).withTop(15).withHeight(40); // Margen superior de 15
     g.drawFittedText("TFG Synth Plugin", titleArea, juce::Justification::centredTop, 1);
-	g.setFont(customFont);
 }
 
-void SynthAudioProcessorEditor::resized()
+void SynthAudioProcessorEditor::layoutContent()
 {
 
     const int margin = 20;
     const int controlHeight = 30;
     const int titleHeight = 25;
-
-    // Ttulos
-    waveformTitleLabel.setText("Controles de Volumen y Forma de Onda", juce::dontSendNotification);
-	waveformTitleLabel.setFont(customFont);
-    adsrTitleLabel.setText("Controles ADSR", juce::dontSendNotification);
-    reverbTitleLabel.setText("Controles de Reverb", juce::dontSendNotification);
-
-    waveformTitleLabel.setJustificationType(juce::Justification::centred);
-    adsrTitleLabel.setJustificationType(juce::Justification::centred);
-    reverbTitleLabel.setJustificationType(juce::Justification::centred);
+    const int analyserHeight = 180;
 
     int y = 50;
 
-    setSize(800, y + controlHeight + 500);
-
     // Waveform y volumen
-    waveformTitleLabel.setBounds(0, y, getWidth(), titleHeight);
+    waveformTitleLabel.setBounds(0, y, designWidth, titleHeight);
     y += titleHeight + 10;
 
-    int selectorWidth = 180;
-    waveformSelector.setBounds((getWidth() - selectorWidth) / 2, y, selectorWidth, controlHeight);
+    int selectorWidth = 140;
+    waveformSelector.setBounds((designWidth - selectorWidth) / 2, y, selectorWidth, controlHeight);
+    wavetableSelector.setBounds(160, y, 150, controlHeight);
+    wavetablePositionSlider.setBounds((designWidth + selectorWidth) / 2 + 10, y, 140, controlHeight);
+    partSelector.setBounds(margin, y, 120, controlHeight);
+    multitimbralToggleButton.setBounds(designWidth - margin - 150, y, 150, controlHeight);
     y += controlHeight + 10;
 
     int volumeSliderWidth = 300;
-    volumeSlider.setBounds((getWidth() - volumeSliderWidth) / 2, y, volumeSliderWidth, controlHeight);
+    volumeSlider.setBounds((designWidth - volumeSliderWidth) / 2, y, volumeSliderWidth, controlHeight);
+    arpModeSelector.setBounds(margin, y, 120, controlHeight);
+    arpRateSelector.setBounds(designWidth - margin - 120, y, 120, controlHeight);
     y += controlHeight + 30;
 
     // ADSR
-    adsrTitleLabel.setBounds(0, y, getWidth(), titleHeight);
+    adsrTitleLabel.setBounds(0, y, designWidth, titleHeight);
     y += titleHeight + 10;
 
     int adsrSliderSize = 100;
     int adsrSpacing = 30;
     int adsrTotalWidth = 4 * adsrSliderSize + 3 * adsrSpacing;
-    int adsrStartX = (getWidth() - adsrTotalWidth) / 2;
+    int adsrStartX = (designWidth - adsrTotalWidth) / 2;
     int adsrTop = y;
 
     auto placeADSRSlider = [adsrTop, adsrSliderSize](juce::Slider& s, juce::Label& l, int x) {
@@ -189,15 +491,22 @@ void SynthAudioProcessorEditor::resized()
     placeADSRSlider(sustainSlider, sustainLabel, adsrStartX + 2 * (adsrSliderSize + adsrSpacing));
     placeADSRSlider(releaseSlider, releaseLabel, adsrStartX + 3 * (adsrSliderSize + adsrSpacing));
 
+    // Gobernador de calidad a la derecha de la ADSR
+    governorToggleButton.setBounds(designWidth - margin - 125, adsrTop, 125, controlHeight);
+    qualityTierLabel.setBounds(designWidth - margin - 125, adsrTop + controlHeight + 5, 125, controlHeight);
+
+    playModeSelector.setBounds(margin, adsrTop + (adsrSliderSize - controlHeight) / 2, 120, controlHeight);
+    placeADSRSlider(glideSlider, glideLabel, designWidth - margin - adsrSliderSize);
+
     y = adsrTop + adsrSliderSize + 40;
 
     // Reverb
-    reverbTitleLabel.setBounds(0, y, getWidth(), titleHeight);
+    reverbTitleLabel.setBounds(0, y, designWidth, titleHeight);
     y += titleHeight + 10;
 
-    int numReverbSliders = 6;
+    int numReverbSliders = 7;
     int reverbSliderSize = 90;
-    int reverbSpacing = (getWidth() - 2 * margin - numReverbSliders * reverbSliderSize) / (numReverbSliders - 1);
+    int reverbSpacing = (designWidth - 2 * margin - numReverbSliders * reverbSliderSize) / (numReverbSliders - 1);
     int reverbTop = y;
     int reverbX = margin;
 
@@ -206,6 +515,7 @@ void SynthAudioProcessorEditor::resized()
         l.setBounds(x, reverbTop + reverbSliderSize, reverbSliderSize, 20);
         };
 
+    placeReverbSlider(reverbSendSlider, reverbSendLabel, reverbX); reverbX += reverbSliderSize + reverbSpacing;
     placeReverbSlider(reverbRoomSlider, reverbRoomLabel, reverbX); reverbX += reverbSliderSize + reverbSpacing;
     placeReverbSlider(reverbDampingSlider, reverbDampingLabel, reverbX); reverbX += reverbSliderSize + reverbSpacing;
     placeReverbSlider(reverbWetSlider, reverbWetLabel, reverbX); reverbX += reverbSliderSize + reverbSpacing;
@@ -213,7 +523,43 @@ void SynthAudioProcessorEditor::resized()
     placeReverbSlider(reverbWidthSlider, reverbWidthLabel, reverbX); reverbX += reverbSliderSize + reverbSpacing;
     placeReverbSlider(reverbFreezeSlider, reverbFreezeLabel, reverbX);
 
-    reverbToggleButton.setBounds(getWidth() - margin - 150, reverbTop + reverbSliderSize + 30, 150, controlHeight);
+    reverbToggleButton.setBounds(designWidth - margin - 150, reverbTop + reverbSliderSize + 30, 150, controlHeight);
+    tuningButton.setBounds(margin, reverbTop + reverbSliderSize + 30, 220, controlHeight);
+    limiterToggleButton.setBounds((designWidth - 120) / 2, reverbTop + reverbSliderSize + 30, 120, controlHeight);
+    captureToggleButton.setBounds((designWidth + 120) / 2 + 10, reverbTop + reverbSliderSize + 30, 130, controlHeight);
+
+    y = reverbTop + reverbSliderSize + 30 + controlHeight + 15;
+
+    // FM: algoritmo y operador a la izquierda, sus sliders y luego los de panorama
+    fmTitleLabel.setBounds(0, y, designWidth, titleHeight);
+    y += titleHeight + 10;
+
+    const int fmSliderSize = 56;
+    const int fmSliderPitch = 63;
+    const int fmTop = y;
+    int fmX = margin + 130;
+
+    fmAlgorithmSelector.setBounds(margin, fmTop, 120, controlHeight);
+    fmOperatorSelector.setBounds(margin, fmTop + controlHeight + 10, 120, controlHeight);
+
+    auto placeFmSlider = [fmSliderSize, fmTop](juce::Slider& s, juce::Label& l, int x) {
+        s.setBounds(x, fmTop, fmSliderSize, fmSliderSize);
+        l.setBounds(x - 4, fmTop + fmSliderSize, fmSliderSize + 8, 20);
+        };
+
+    placeFmSlider(fmFeedbackSlider, fmFeedbackLabel, fmX); fmX += fmSliderPitch;
+    placeFmSlider(fmRatioSlider, fmRatioLabel, fmX); fmX += fmSliderPitch;
+    placeFmSlider(fmLevelSlider, fmLevelLabel, fmX); fmX += fmSliderPitch;
+    placeFmSlider(fmAttackSlider, fmAttackLabel, fmX); fmX += fmSliderPitch;
+    placeFmSlider(fmDecaySlider, fmDecayLabel, fmX); fmX += fmSliderPitch;
+    placeFmSlider(fmSustainSlider, fmSustainLabel, fmX); fmX += fmSliderPitch;
+    placeFmSlider(fmReleaseSlider, fmReleaseLabel, fmX); fmX += fmSliderPitch;
+    placeFmSlider(panSlider, panLabel, fmX); fmX += fmSliderPitch;
+    placeFmSlider(panKeyTrackingSlider, panKeyTrackingLabel, fmX); fmX += fmSliderPitch;
+    placeFmSlider(panSpreadSlider, panSpreadLabel, fmX);
+
+    // Osciloscopio y espectro
+    analyser->setBounds(margin, designHeight - analyserHeight - margin, designWidth - 2 * margin, analyserHeight);
 
 
 }
@@ -226,6 +572,45 @@ void SynthAudioProcessorEditor::sliderValueChanged(juce::Slider* slider)
         audioProcessor.setCurrentVolume(volumeSlider.getValue());
     }
 
+    if (slider == &wavetablePositionSlider)
+    {
+        audioProcessor.setCurrentWavetablePosition(wavetablePositionSlider.getValue());
+    }
+
+    if (slider == &glideSlider)
+    {
+        audioProcessor.setGlideTime(glideSlider.getValue());
+    }
+
+    if (slider == &reverbSendSlider)
+    {
+        audioProcessor.setCurrentReverbSend(reverbSendSlider.getValue());
+    }
+
+    if (slider == &panSlider || slider == &panKeyTrackingSlider || slider == &panSpreadSlider)
+    {
+        audioProcessor.setCurrentPan(panSlider.getValue(), panKeyTrackingSlider.getValue(), panSpreadSlider.getValue());
+    }
+
+    if (slider == &fmFeedbackSlider)
+    {
+        audioProcessor.setCurrentFmFeedback(fmFeedbackSlider.getValue());
+    }
+
+    if (slider == &fmRatioSlider || slider == &fmLevelSlider || slider == &fmAttackSlider ||
+        slider == &fmDecaySlider || slider == &fmSustainSlider || slider == &fmReleaseSlider)
+    {
+        audioProcessor.setCurrentFmOperator(
+            fmOperatorSelector.getSelectedId() - 1,
+            fmRatioSlider.getValue(),
+            fmLevelSlider.getValue(),
+            fmAttackSlider.getValue(),
+            fmDecaySlider.getValue(),
+            fmSustainSlider.getValue(),
+            fmReleaseSlider.getValue()
+        );
+    }
+
     if (slider == &attackSlider || slider == &decaySlider || slider == &sustainSlider || slider == &releaseSlider)
     {
         audioProcessor.setCurrentADSRParameters(
@@ -10,23 +10,79 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "AnalyserComponent.h"
 
-class SynthAudioProcessorEditor : public juce::AudioProcessorEditor, private juce::Slider::Listener
+// Recursos compartidos por todos los editores abiertos en el proceso
+struct SharedEditorResources
+{
+    SharedEditorResources();
+
+    juce::Typeface::Ptr trashHandTypeface;
+    juce::LookAndFeel_V4 neonLookAndFeel;
+};
+
+class SynthAudioProcessorEditor : public juce::AudioProcessorEditor, private juce::Slider::Listener, private juce::Timer
 {
 public:
     SynthAudioProcessorEditor(SynthAudioProcessor&);
     ~SynthAudioProcessorEditor() override;
 
     void paint(juce::Graphics&) override;
+    void paintOverChildren(juce::Graphics&) override;
     void resized() override;
 
+    // Tiempo del hilo de la GUI por cada repintado del editor
+    struct PaintStats
+    {
+        double lastFrameMs = 0.0;
+        double averageFrameMs = 0.0;
+        double maxFrameMs = 0.0;
+        int numFrames = 0;
+    };
+    const PaintStats& getPaintStats() const { return paintStats; }
+
+    // Se llama en el primer paint con el tiempo desde que se creo el editor
+    std::function<void(double openToFirstPaintMs)> onFirstPaint;
+    double getOpenToFirstPaintMs() const { return openToFirstPaintMs; }
 
 private:
+    static constexpr int designWidth = 800;
+    static constexpr int designHeight = 890;
+
+    juce::int64 openTicks = juce::Time::getHighResolutionTicks();
+
+    void buildControls();
+    void layoutContent();
+    void refreshPartControls();
+    void refreshFmOperatorControls();
+    void chooseTuningFile();
+    void renderBackground();
+    // Refresca el nivel de calidad del gobernador de CPU
+    void timerCallback() override;
+
+    juce::SharedResourcePointer<SharedEditorResources> sharedResources;
+    double openToFirstPaintMs = -1.0;
+    bool controlsBuilt = false;
+
+    juce::Component content;
+    juce::Image backgroundCache;
+    juce::Font titleFont{ juce::FontOptions("Arial", 24.0f, juce::Font::bold) };
+    PaintStats paintStats;
+    juce::int64 paintStartTicks = 0;
+
     juce::Slider volumeSlider;
     void sliderValueChanged(juce::Slider* slider);
     SynthAudioProcessor& audioProcessor;
 
     juce::ComboBox waveformSelector;
+    juce::ComboBox wavetableSelector;
+    juce::Slider wavetablePositionSlider;
+    juce::ComboBox partSelector;
+    juce::ComboBox arpModeSelector, arpRateSelector;
+    juce::ComboBox playModeSelector;
+    juce::Slider glideSlider;
+    juce::Label glideLabel;
+    juce::ToggleButton multitimbralToggleButton{ "Multitimbral" };
 
     juce::Slider attackSlider;
     juce::Slider decaySlider;
@@ -39,13 +95,35 @@ private:
     juce::Label releaseLabel;
 
 
+    juce::Slider reverbSendSlider;
+    juce::Label reverbSendLabel;
     juce::Slider reverbRoomSlider, reverbDampingSlider, reverbWetSlider, reverbDrySlider, reverbWidthSlider, reverbFreezeSlider;
     juce::Label reverbRoomLabel, reverbDampingLabel, reverbWetLabel, reverbDryLabel, reverbWidthLabel, reverbFreezeLabel;
     juce::ToggleButton reverbToggleButton{ "Enable Reverb" };
+    juce::ToggleButton limiterToggleButton{ "Limiter" };
+    juce::ToggleButton governorToggleButton{ "Auto Quality" };
+    // Captura de la sesion en Documentos/SynthCaptures, para SynthTools replay
+    juce::ToggleButton captureToggleButton{ "Capturar" };
+    juce::Label qualityTierLabel;
+
+    // FM de la parte editada; los sliders de operador muestran el operador elegido
+    juce::ComboBox fmAlgorithmSelector, fmOperatorSelector;
+    juce::Slider fmFeedbackSlider, fmRatioSlider, fmLevelSlider, fmAttackSlider, fmDecaySlider, fmSustainSlider, fmReleaseSlider;
+    juce::Label fmFeedbackLabel, fmRatioLabel, fmLevelLabel, fmAttackLabel, fmDecayLabel, fmSustainLabel, fmReleaseLabel;
+
+    // Panorama de la parte editada: fijo, por nota y aleatorio
+    juce::Slider panSlider, panKeyTrackingSlider, panSpreadSlider;
+    juce::Label panLabel, panKeyTrackingLabel, panSpreadLabel;
+
+    juce::TextButton tuningButton;
+    std::unique_ptr<juce::FileChooser> tuningChooser;
 
     juce::Label waveformTitleLabel;
     juce::Label adsrTitleLabel;
     juce::Label reverbTitleLabel;
+    juce::Label fmTitleLabel;
+
+    std::unique_ptr<AnalyserComponent> analyser;
 
     juce::Font customFont;
 
@@ -22,8 +22,25 @@ SynthAudioProcessor::SynthAudioProcessor()
     )
 #endif
 {
-    synth.addSound(new SynthSound());
-    synth.addVoice(new SynthVoice());
+    // Elegir una sola vez, al cargar el plugin, la mejor variante SIMD de los kernels
+    DspKernels::get();
+
+    for (int i = 0; i < numParts; ++i)
+        parts[(size_t)i].midiChannel = i + 1;
+
+    // Las 16 partes comparten las mismas voces de oscilador
+    for (int i = 0; i < numOscillatorVoices; ++i)
+        synth.addVoice(new SynthVoice(tuning));
+
+    synth.setTraceRecorder(&trace);
+
+    rebuildPartSounds();
+    updateReverb(currentRoomSize, currentDamping, currentWetLevel, currentDryLevel, currentWidth, currentFreeze);
+
+    formatManager.registerBasicFormats();
+
+    for (int i = 0; i < numSamplerVoices; ++i)
+        synth.addVoice(new StreamingSamplerVoice(diskStreamer, i));
 }
 
 SynthAudioProcessor::~SynthAudioProcessor()
@@ -65,7 +82,8 @@ bool SynthAudioProcessor::isMidiEffect() const
 
 double SynthAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // Las colas del eco y de la reverb siguen sonando al acabar las notas
+    return effects.getTailSeconds();
 }
 
 int SynthAudioProcessor::getNumPrograms()
@@ -97,13 +115,54 @@ void SynthAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     synth.setCurrentPlaybackSampleRate(sampleRate);
 
+    // Toda la memoria de las voces y de la instancia sale de un solo bloque
+    const int numOutputChannels = getTotalNumOutputChannels();
+    analyserScratchSize = juce::jmax(1, samplesPerBlock);
+    arenaBytesPerVoice = SynthVoice::getArenaBytesRequired(samplesPerBlock);
+    arena.reset(arenaBytesPerVoice * (size_t)getNumOscillatorVoices()
+                + EffectSendBus::getArenaBytesRequired(numOutputChannels, samplesPerBlock)
+                + MasterEffectChain::getArenaBytesRequired(sampleRate, numOutputChannels, samplesPerBlock)
+                + MasterLimiter::getArenaBytesRequired(numOutputChannels, samplesPerBlock, sampleRate)
+                + DspArena::bytesForFloats(juce::jmin(maxInternalBlockSize, samplesPerBlock)) * (size_t)numOutputChannels
+                + DspArena::bytesForFloats(analyserScratchSize));
+
+    sendBus.prepare(arena, numOutputChannels, samplesPerBlock);
+    effects.prepare(arena, sampleRate, numOutputChannels, samplesPerBlock);
+    limiter.prepare(arena, numOutputChannels, samplesPerBlock, sampleRate);
+
+    std::array<float*, 2> chunkChannels{};
+    jassert(numOutputChannels <= (int)chunkChannels.size());
+    for (int channel = 0; channel < numOutputChannels; ++channel)
+        chunkChannels[(size_t)channel] = arena.allocateFloats(juce::jmin(maxInternalBlockSize, samplesPerBlock));
+
+    chunkBuffer.setDataToReferTo(chunkChannels.data(), numOutputChannels, juce::jmin(maxInternalBlockSize, samplesPerBlock));
+    chunkMidi.ensureSize(4096);
+    bufferedChunkSize = 0;
+    preparedBlockSize = samplesPerBlock;
+    updateLatency();
+    governor.prepare(sampleRate, samplesPerBlock);
+    arpeggiator.prepare(sampleRate);
+    tuning.prepare(sampleRate);
+    capture.capturePrepare(sampleRate, samplesPerBlock);
+
     for (int i = 0; i < synth.getNumVoices(); i++)
     {
         if (auto voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
         {
-            voice->prepareToPlay(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+            voice->prepareToPlay(sampleRate, samplesPerBlock, arena, sendBus);
+            voice->setNoiseSeed(noiseSeed + (juce::uint32)i * 0x632be5abu);
+        }
+        else if (auto samplerVoice = dynamic_cast<StreamingSamplerVoice*>(synth.getVoice(i)))
+        {
+            samplerVoice->prepareToPlay(sampleRate);
         }
     }
+
+    // Diezmar el analizador para que trabaje siempre a unos 44.1/48 kHz
+    analyserDecimation = juce::jmax(1, juce::roundToInt(sampleRate / 48000.0));
+    analyserDecimationCount = 0;
+    analyserAccumulator = 0.0f;
+    analyserScratch = arena.allocateFloats(analyserScratchSize);
 }
 
 void SynthAudioProcessor::releaseResources()
@@ -141,6 +200,17 @@ bool SynthAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) con
 void SynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+
+    const auto blockStartTicks = juce::Time::getHighResolutionTicks();
+    traceBlockStart(midiMessages, buffer.getNumSamples());
+
+    // Calidad segun la carga de los bloques anteriores, o la fijada; la captura
+    // la guarda con el bloque y luego se mide este
+    const int forcedTier = forcedQualityTier.load(std::memory_order_relaxed);
+    const int qualityTier = forcedTier >= 0 ? forcedTier : governor.update(buffer.getNumSamples(), ! isNonRealtime());
+    capture.captureBlockStart(midiMessages, buffer.getNumSamples(), getPlayHead(), qualityTier);
+    applyQualityTier(qualityTier);
+    juce::AudioProcessLoadMeasurer::ScopedTimer loadTimer(governor.getLoadMeasurer(), buffer.getNumSamples());
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -163,7 +233,219 @@ void SynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
         }
     }
 
-    synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    // El arpegiador genera sus notas antes de que lleguen al sintetizador
+    const auto& midiToRender = arpeggiator.process(midiMessages, buffer.getNumSamples(), getPlayHead());
+
+    const int numSamples = buffer.getNumSamples();
+
+    // El eco de la cadena maestra sigue el tempo del host
+    if (auto* playHead = getPlayHead())
+        if (auto position = playHead->getPosition())
+            if (auto hostBpm = position->getBpm())
+                effects.setTempo(juce::jlimit(20.0, 999.0, *hostBpm));
+
+    // Los buffers internos tienen el tamano de bloque de prepareToPlay: bloques
+    // mayores del host, o el tamano interno fijo, se renderizan por trozos
+    const int requested = internalBlockSize.load(std::memory_order_relaxed);
+    const int chunkSize = getChunkSize(requested);
+
+    if (requested > 0 && internalBlockBuffered.load(std::memory_order_relaxed))
+    {
+        processBuffered(buffer, midiToRender, chunkSize);
+    }
+    else
+    {
+        bufferedChunkSize = 0;
+
+        for (int start = 0; start < numSamples; start += chunkSize)
+            renderChunk(buffer, midiToRender, start, juce::jmin(chunkSize, numSamples - start));
+    }
+
+    if (analyserActive.load(std::memory_order_relaxed))
+        pushToAnalyser(buffer);
+
+    const auto blockSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockStartTicks);
+    traceBlockEnd(blockSeconds, numSamples);
+    capture.captureBlockEnd(blockSeconds, buffer);
+}
+
+void SynthAudioProcessor::traceBlockStart(const juce::MidiBuffer& midi, int numSamples) noexcept
+{
+    trace.record(TraceRecorder::BlockStart, numSamples);
+
+    for (const auto metadata : midi)
+    {
+        const auto* data = metadata.data;
+
+        // Solo mensajes de canal; los SysEx no caben en un evento
+        if (metadata.numBytes <= 3)
+            trace.record(TraceRecorder::Midi, data[0],
+                         (metadata.numBytes > 1 ? data[1] << 8 : 0) | (metadata.numBytes > 2 ? data[2] : 0),
+                         (float)metadata.samplePosition);
+    }
+
+    // Los cambios de parametros se ven como saltos de version de cada parte
+    for (int i = 0; i < numParts; ++i)
+    {
+        const auto version = parts[(size_t)i].version.load(std::memory_order_relaxed);
+
+        if (version != tracedPartVersions[(size_t)i])
+        {
+            tracedPartVersions[(size_t)i] = version;
+            trace.record(TraceRecorder::ParameterChange, i, (juce::int32)version);
+        }
+    }
+}
+
+void SynthAudioProcessor::traceBlockEnd(double seconds, int numSamples) noexcept
+{
+    const auto load = (float)(seconds * getSampleRate() / (double)juce::jmax(1, numSamples));
+
+    trace.record(TraceRecorder::BlockEnd, numSamples, 0, load);
+
+    // Bloque que no llego a tiempo: se marca y se pide un volcado al hilo de fondo
+    if (load > 1.0f)
+    {
+        trace.record(TraceRecorder::Overrun, numSamples, 0, load);
+        trace.requestDump();
+    }
+}
+
+void SynthAudioProcessor::applyQualityTier(int tier)
+{
+    if (tier == appliedQualityTier)
+        return;
+
+    trace.record(TraceRecorder::QualityTier, tier, 0, governor.getLoad());
+
+    // Cada nivel suma un recorte mas al anterior
+    limiter.setTruePeakDetection(tier < QualityGovernor::LimiterSamplePeak);
+    effects.getReverb().setMono(tier >= QualityGovernor::ReverbMono);
+    synth.setMaxPolyphony(tier >= QualityGovernor::Polyphony16 ? 16
+                          : tier >= QualityGovernor::Polyphony32 ? 32 : numOscillatorVoices + numSamplerVoices);
+
+    if (tier > appliedQualityTier)
+        synth.enforcePolyphony();
+
+    appliedQualityTier = tier;
+}
+
+void SynthAudioProcessor::setForcedQualityTier(int tier)
+{
+    forcedQualityTier = tier < 0 ? -1 : juce::jmin(tier, QualityGovernor::numTiers - 1);
+}
+
+void SynthAudioProcessor::renderChunk(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi, int startSample, int numSamples)
+{
+    sendBus.beginBlock(startSample, numSamples, effects.needsSendBus());
+    synth.renderNextBlock(buffer, midi, startSample, numSamples);
+
+    // Compensacion de la ley de panorama, una vez por bus y no en cada voz
+    if (buffer.getNumChannels() > 1)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel, startSample),
+                                                  SharedDspResources::panMakeupGain, numSamples);
+
+        if (sendBus.isActive())
+            for (int channel = 0; channel < sendBus.getNumChannels(); ++channel)
+                juce::FloatVectorOperations::multiply(sendBus.getWritePointer(channel, startSample),
+                                                      SharedDspResources::panMakeupGain, numSamples);
+    }
+
+    effects.process(buffer, startSample, numSamples, sendBus);
+
+    if (limiter.isEnabled())
+        limiter.process(buffer, startSample, numSamples);
+}
+
+void SynthAudioProcessor::processBuffered(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi, int chunkSize)
+{
+    // Recien activado o con otro tamano: se empieza con un trozo de silencio
+    if (chunkSize != bufferedChunkSize)
+    {
+        bufferedChunkSize = chunkSize;
+        bufferedFill = 0;
+        chunkMidi.clear();
+        chunkBuffer.clear();
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), chunkBuffer.getNumChannels());
+
+    for (int position = 0; position < numSamples;)
+    {
+        const int num = juce::jmin(numSamples - position, chunkSize - bufferedFill);
+
+        // Sale el trozo anterior, justo chunkSize muestras despues de su MIDI
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.copyFrom(channel, position, chunkBuffer, channel, bufferedFill, num);
+
+        chunkMidi.addEvents(midi, position, num, bufferedFill - position);
+        bufferedFill += num;
+        position += num;
+
+        if (bufferedFill == chunkSize)
+        {
+            chunkBuffer.clear(0, chunkSize);
+            renderChunk(chunkBuffer, chunkMidi, 0, chunkSize);
+            chunkMidi.clear();
+            bufferedFill = 0;
+        }
+    }
+}
+
+void SynthAudioProcessor::pushToAnalyser(const juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+
+    if (numChannels == 0 || analyserScratchSize == 0)
+        return;
+
+    if (analyserDecimation == 1)
+    {
+        // Caso habitual: mezcla a mono con operaciones vectoriales
+        const float channelScale = 1.0f / (float)numChannels;
+
+        for (int start = 0; start < numSamples; start += analyserScratchSize)
+        {
+            const int num = juce::jmin(analyserScratchSize, numSamples - start);
+            juce::FloatVectorOperations::copyWithMultiply(analyserScratch, buffer.getReadPointer(0, start), channelScale, num);
+
+            for (int channel = 1; channel < numChannels; ++channel)
+                juce::FloatVectorOperations::addWithMultiply(analyserScratch, buffer.getReadPointer(channel, start), channelScale, num);
+
+            analyserFifo.push(analyserScratch, num);
+        }
+
+        return;
+    }
+
+    const float scale = 1.0f / (float)(numChannels * analyserDecimation);
+    int numOut = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            analyserAccumulator += buffer.getSample(channel, i);
+
+        if (++analyserDecimationCount == analyserDecimation)
+        {
+            analyserScratch[numOut++] = analyserAccumulator * scale;
+            analyserAccumulator = 0.0f;
+            analyserDecimationCount = 0;
+
+            if (numOut == analyserScratchSize)
+            {
+                analyserFifo.push(analyserScratch, numOut);
+                numOut = 0;
+            }
+        }
+    }
+
+    if (numOut > 0)
+        analyserFifo.push(analyserScratch, numOut);
 }
 
 //==============================================================================
@@ -187,15 +469,15 @@ void SynthAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
     juce::ValueTree state("SynthState");
 
     // Guardar el valor del volumen en el estado
-    state.setProperty("volume", currentVolume, nullptr);
+    state.setProperty("volume", parts[0].volume.load(), nullptr);
     // Guardar el tipo de onda actual en el estado
-    state.setProperty("waveform", currentWaveform, nullptr);
+    state.setProperty("waveform", parts[0].waveform.load(), nullptr);
 
     // Guardar los parmetros ADSR en el estado
-    state.setProperty("attack", currentAttack, nullptr);
-    state.setProperty("decay", currentDecay, nullptr);
-    state.setProperty("sustain", currentSustain, nullptr);
-    state.setProperty("release", currentRelease, nullptr);
+    state.setProperty("attack", parts[0].attack.load(), nullptr);
+    state.setProperty("decay", parts[0].decay.load(), nullptr);
+    state.setProperty("sustain", parts[0].sustain.load(), nullptr);
+    state.setProperty("release", parts[0].release.load(), nullptr);
 
     // Guardar parmetros de reverb
     state.setProperty("roomSize", currentRoomSize, nullptr);
@@ -204,7 +486,126 @@ void SynthAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
     state.setProperty("dryLevel", currentDryLevel, nullptr);
     state.setProperty("width", currentWidth, nullptr);
     state.setProperty("freeze", currentFreeze, nullptr);
-    state.setProperty("reverbEnabled", reverbEnabled, nullptr);
+    state.setProperty("reverbEnabled", getReverbEnabled(), nullptr);
+    state.setProperty("limiterEnabled", limiter.isEnabled(), nullptr);
+    state.setProperty("limiterCeiling", limiter.getCeilingDecibels(), nullptr);
+    state.setProperty("limiterRelease", limiter.getReleaseSeconds(), nullptr);
+    state.setProperty("qualityGovernor", governor.isEnabled(), nullptr);
+    // Solo lectura: para ver en un proyecto guardado si la maquina iba sobrecargada
+    state.setProperty("qualityTier", QualityGovernor::getTierName(governor.getTier()), nullptr);
+    state.setProperty("internalBlockSize", internalBlockSize.load(), nullptr);
+    state.setProperty("internalBlockBuffered", internalBlockBuffered.load(), nullptr);
+
+    juce::ValueTree arpState("Arpeggiator");
+    arpState.setProperty("mode", arpeggiator.getMode(), nullptr);
+    arpState.setProperty("rate", arpeggiator.getRate(), nullptr);
+    arpState.setProperty("gate", arpeggiator.getGate(), nullptr);
+    arpState.setProperty("octaves", arpeggiator.getOctaves(), nullptr);
+    arpState.setProperty("numSteps", arpeggiator.getNumSteps(), nullptr);
+
+    for (int i = 0; i < Arpeggiator::maxSteps; ++i)
+    {
+        juce::ValueTree stepState("Step");
+        stepState.setProperty("offset", arpeggiator.getStepOffset(i), nullptr);
+        stepState.setProperty("velocity", arpeggiator.getStepVelocity(i), nullptr);
+        arpState.appendChild(stepState, nullptr);
+    }
+
+    state.appendChild(arpState, nullptr);
+
+    // Cadena maestra: orden, etapas activas y parametros (los de la reverb van arriba)
+    juce::ValueTree effectsState("Effects");
+    juce::StringArray order;
+    int enabledMask = 0;
+
+    for (int i = 0; i < MasterEffectChain::numStages; ++i)
+    {
+        order.add(juce::String(effects.getOrder()[(size_t)i]));
+        enabledMask |= effects.isStageEnabled(i) ? (1 << i) : 0;
+    }
+
+    effectsState.setProperty("order", order.joinIntoString(" "), nullptr);
+    effectsState.setProperty("enabled", enabledMask, nullptr);
+    effectsState.setProperty("chorusRate", effects.getChorus().getRate(), nullptr);
+    effectsState.setProperty("chorusDepth", effects.getChorus().getDepth(), nullptr);
+    effectsState.setProperty("chorusMix", effects.getChorus().getMix(), nullptr);
+    effectsState.setProperty("phaserRate", effects.getPhaser().getRate(), nullptr);
+    effectsState.setProperty("phaserDepth", effects.getPhaser().getDepth(), nullptr);
+    effectsState.setProperty("phaserFeedback", effects.getPhaser().getFeedback(), nullptr);
+    effectsState.setProperty("phaserMix", effects.getPhaser().getMix(), nullptr);
+    effectsState.setProperty("delayDivision", effects.getDelay().getDivision(), nullptr);
+    effectsState.setProperty("delayFeedback", effects.getDelay().getFeedback(), nullptr);
+    effectsState.setProperty("delayMix", effects.getDelay().getMix(), nullptr);
+    effectsState.setProperty("delayMode", effects.getDelay().getMode(), nullptr);
+    effectsState.setProperty("delayLowCut", effects.getDelay().getLowCut(), nullptr);
+    effectsState.setProperty("delayHighCut", effects.getDelay().getHighCut(), nullptr);
+    effectsState.setProperty("delayModRate", effects.getDelay().getModulationRate(), nullptr);
+    effectsState.setProperty("delayModDepth", effects.getDelay().getModulationDepth(), nullptr);
+    effectsState.setProperty("distortionDrive", effects.getDistortion().getDrive(), nullptr);
+    effectsState.setProperty("distortionMix", effects.getDistortion().getMix(), nullptr);
+    effectsState.setProperty("eqLowGain", effects.getEq().getLowGain(), nullptr);
+    effectsState.setProperty("eqMidGain", effects.getEq().getMidGain(), nullptr);
+    effectsState.setProperty("eqMidFrequency", effects.getEq().getMidFrequency(), nullptr);
+    effectsState.setProperty("eqHighGain", effects.getEq().getHighGain(), nullptr);
+    state.appendChild(effectsState, nullptr);
+
+    // La afinacion se guarda con el texto de los ficheros, no con su ruta
+    if (const auto scalaText = tuning.getScalaText(); scalaText.isNotEmpty())
+    {
+        state.setProperty("scala", scalaText, nullptr);
+        state.setProperty("keyboardMapping", tuning.getKeyboardMappingText(), nullptr);
+    }
+
+    // Las propiedades de arriba son las de la parte 1, para estados antiguos
+    state.setProperty("multitimbral", multitimbral, nullptr);
+    state.setProperty("playMode", synth.getPlayMode(), nullptr);
+    state.setProperty("glideTime", synth.getGlideTime(), nullptr);
+    state.setProperty("glideConstantRate", synth.getGlideConstantRate(), nullptr);
+    state.setProperty("noiseSeed", (juce::int64)noiseSeed, nullptr);
+
+    for (int i = 0; i < numParts; ++i)
+    {
+        auto& part = parts[(size_t)i];
+        juce::ValueTree partState("Part");
+        partState.setProperty("index", i, nullptr);
+        partState.setProperty("volume", part.volume.load(), nullptr);
+        partState.setProperty("waveform", part.waveform.load(), nullptr);
+        partState.setProperty("attack", part.attack.load(), nullptr);
+        partState.setProperty("decay", part.decay.load(), nullptr);
+        partState.setProperty("sustain", part.sustain.load(), nullptr);
+        partState.setProperty("release", part.release.load(), nullptr);
+        partState.setProperty("reverbSend", part.reverbSend.load(), nullptr);
+        partState.setProperty("wavetable", part.wavetable.load(), nullptr);
+        partState.setProperty("wavetablePosition", part.wavetablePosition.load(), nullptr);
+        partState.setProperty("wavetableScan", part.wavetableScan.load(), nullptr);
+        partState.setProperty("pan", part.pan.load(), nullptr);
+        partState.setProperty("panKeyTracking", part.panKeyTracking.load(), nullptr);
+        partState.setProperty("panSpread", part.panSpread.load(), nullptr);
+        partState.setProperty("drift", part.drift.load(), nullptr);
+        partState.setProperty("fmAlgorithm", part.fmAlgorithm.load(), nullptr);
+        partState.setProperty("fmFeedback", part.fmFeedback.load(), nullptr);
+
+        for (int op = 0; op < FmOperators::numOperators; ++op)
+        {
+            const auto& fmOperator = part.fmOperators[(size_t)op];
+            juce::ValueTree operatorState("FmOperator");
+            operatorState.setProperty("index", op, nullptr);
+            operatorState.setProperty("ratio", fmOperator.ratio.load(), nullptr);
+            operatorState.setProperty("level", fmOperator.level.load(), nullptr);
+            operatorState.setProperty("attack", fmOperator.attack.load(), nullptr);
+            operatorState.setProperty("decay", fmOperator.decay.load(), nullptr);
+            operatorState.setProperty("sustain", fmOperator.sustain.load(), nullptr);
+            operatorState.setProperty("release", fmOperator.release.load(), nullptr);
+            partState.appendChild(operatorState, nullptr);
+        }
+
+        partState.setProperty("channel", part.midiChannel, nullptr);
+        partState.setProperty("lowNote", part.keyZone.lowNote, nullptr);
+        partState.setProperty("highNote", part.keyZone.highNote, nullptr);
+        partState.setProperty("lowVelocity", part.keyZone.lowVelocity, nullptr);
+        partState.setProperty("highVelocity", part.keyZone.highVelocity, nullptr);
+        state.appendChild(partState, nullptr);
+    }
 
     // Serializar el ValueTree a un MemoryBlock
     juce::MemoryOutputStream stream(destData, true);
@@ -217,6 +618,13 @@ void SynthAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
     juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
     juce::ValueTree state = juce::ValueTree::readFromStream(stream);
 
+    if (capture.isCapturing())
+        capture.captureState(data, sizeInBytes);
+
+    const juce::ScopedValueSetter<bool> restoring(restoringState, true);
+
+    setEditedPart(0);
+
     if (state.hasProperty("volume"))
     {
         float volume = (float)state["volume"];
@@ -256,114 +664,558 @@ void SynthAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
         setReverbEnabled((bool)state["reverbEnabled"]);
     }
 
+    setLimiterEnabled((bool)state.getProperty("limiterEnabled", true));
+    limiter.setCeilingDecibels((float)state.getProperty("limiterCeiling", -1.0f));
+    limiter.setReleaseSeconds((float)state.getProperty("limiterRelease", 0.1f));
+    setQualityGovernorEnabled((bool)state.getProperty("qualityGovernor", true));
+    setInternalBlockSize((int)state.getProperty("internalBlockSize", 0), (bool)state.getProperty("internalBlockBuffered", false));
+
+    for (const auto& partState : state)
+    {
+        if (! partState.hasType("Part"))
+            continue;
+
+        const int index = (int)partState["index"];
+
+        if (! juce::isPositiveAndBelow(index, numParts))
+            continue;
+
+        auto& part = parts[(size_t)index];
+        part.volume = (float)partState.getProperty("volume", part.volume.load());
+        part.waveform = (int)partState.getProperty("waveform", part.waveform.load());
+        part.attack = (float)partState.getProperty("attack", part.attack.load());
+        part.decay = (float)partState.getProperty("decay", part.decay.load());
+        part.sustain = (float)partState.getProperty("sustain", part.sustain.load());
+        part.release = (float)partState.getProperty("release", part.release.load());
+        part.reverbSend = (float)partState.getProperty("reverbSend", part.reverbSend.load());
+        part.wavetable = (int)partState.getProperty("wavetable", part.wavetable.load());
+        part.wavetablePosition = (float)partState.getProperty("wavetablePosition", part.wavetablePosition.load());
+        part.wavetableScan = (float)partState.getProperty("wavetableScan", part.wavetableScan.load());
+        part.pan = (float)partState.getProperty("pan", part.pan.load());
+        part.panKeyTracking = (float)partState.getProperty("panKeyTracking", part.panKeyTracking.load());
+        part.panSpread = (float)partState.getProperty("panSpread", part.panSpread.load());
+        part.drift = (float)partState.getProperty("drift", part.drift.load());
+        part.fmAlgorithm = (int)partState.getProperty("fmAlgorithm", part.fmAlgorithm.load());
+        part.fmFeedback = (float)partState.getProperty("fmFeedback", part.fmFeedback.load());
+
+        // Los estados sin "index" guardaban los operadores en orden
+        int operatorOrder = 0;
+
+        for (const auto& operatorState : partState)
+        {
+            if (! operatorState.hasType("FmOperator"))
+                continue;
+
+            const int op = (int)operatorState.getProperty("index", operatorOrder++);
+
+            if (! juce::isPositiveAndBelow(op, FmOperators::numOperators))
+                continue;
+
+            auto& fmOperator = part.fmOperators[(size_t)op];
+            fmOperator.ratio = (float)operatorState.getProperty("ratio", fmOperator.ratio.load());
+            fmOperator.level = (float)operatorState.getProperty("level", fmOperator.level.load());
+            fmOperator.attack = (float)operatorState.getProperty("attack", fmOperator.attack.load());
+            fmOperator.decay = (float)operatorState.getProperty("decay", fmOperator.decay.load());
+            fmOperator.sustain = (float)operatorState.getProperty("sustain", fmOperator.sustain.load());
+            fmOperator.release = (float)operatorState.getProperty("release", fmOperator.release.load());
+        }
+        part.changed();
+
+        part.midiChannel = juce::jlimit(0, 16, (int)partState.getProperty("channel", part.midiChannel));
+        part.keyZone.lowNote = (int)partState.getProperty("lowNote", part.keyZone.lowNote);
+        part.keyZone.highNote = (int)partState.getProperty("highNote", part.keyZone.highNote);
+        part.keyZone.lowVelocity = (int)partState.getProperty("lowVelocity", part.keyZone.lowVelocity);
+        part.keyZone.highVelocity = (int)partState.getProperty("highVelocity", part.keyZone.highVelocity);
+    }
+
+    if (auto arpState = state.getChildWithName("Arpeggiator"); arpState.isValid())
+    {
+        arpeggiator.setMode((int)arpState.getProperty("mode", Arpeggiator::Off));
+        arpeggiator.setRate((int)arpState.getProperty("rate", Arpeggiator::Sixteenth));
+        arpeggiator.setGate((float)arpState.getProperty("gate", 0.5f));
+        arpeggiator.setOctaves((int)arpState.getProperty("octaves", 1));
+        arpeggiator.setNumSteps((int)arpState.getProperty("numSteps", Arpeggiator::maxSteps));
+
+        for (int i = 0; i < juce::jmin(Arpeggiator::maxSteps, arpState.getNumChildren()); ++i)
+        {
+            auto stepState = arpState.getChild(i);
+            arpeggiator.setStep(i, (int)stepState.getProperty("offset", 0), (float)stepState.getProperty("velocity", 0.8f));
+        }
+    }
+
+    if (auto effectsState = state.getChildWithName("Effects"); effectsState.isValid())
+    {
+        juce::StringArray order;
+        order.addTokens(effectsState.getProperty("order").toString(), " ", {});
+
+        if (order.size() == MasterEffectChain::numStages)
+        {
+            MasterEffectChain::Order newOrder{};
+
+            for (int i = 0; i < MasterEffectChain::numStages; ++i)
+                newOrder[(size_t)i] = order[i].getIntValue();
+
+            effects.setOrder(newOrder);
+        }
+
+        const int enabledMask = (int)effectsState.getProperty("enabled", 1 << MasterEffectChain::Reverb);
+
+        for (int i = 0; i < MasterEffectChain::numStages; ++i)
+            effects.setStageEnabled(i, (enabledMask & (1 << i)) != 0);
+
+        effects.getChorus().setParameters((float)effectsState.getProperty("chorusRate", 0.8f),
+                                          (float)effectsState.getProperty("chorusDepth", 0.3f),
+                                          (float)effectsState.getProperty("chorusMix", 0.5f));
+        effects.getPhaser().setParameters((float)effectsState.getProperty("phaserRate", 0.5f),
+                                          (float)effectsState.getProperty("phaserDepth", 0.6f),
+                                          (float)effectsState.getProperty("phaserFeedback", 0.3f),
+                                          (float)effectsState.getProperty("phaserMix", 0.5f));
+        effects.getDelay().setParameters((int)effectsState.getProperty("delayDivision", DelayStage::Eighth),
+                                         (float)effectsState.getProperty("delayFeedback", 0.35f),
+                                         (float)effectsState.getProperty("delayMix", 0.3f));
+        effects.getDelay().setMode((int)effectsState.getProperty("delayMode", DelayStage::Stereo));
+        effects.getDelay().setFeedbackFilter((float)effectsState.getProperty("delayLowCut", 80.0f),
+                                             (float)effectsState.getProperty("delayHighCut", 6000.0f));
+        effects.getDelay().setModulation((float)effectsState.getProperty("delayModRate", 0.4f),
+                                         (float)effectsState.getProperty("delayModDepth", 1.0f));
+        effects.getDistortion().setParameters((float)effectsState.getProperty("distortionDrive", 4.0f),
+                                              (float)effectsState.getProperty("distortionMix", 1.0f));
+        effects.getEq().setParameters((float)effectsState.getProperty("eqLowGain", 0.0f),
+                                      (float)effectsState.getProperty("eqMidGain", 0.0f),
+                                      (float)effectsState.getProperty("eqMidFrequency", 1000.0f),
+                                      (float)effectsState.getProperty("eqHighGain", 0.0f));
+    }
+
+    setPlayMode((int)state.getProperty("playMode", SynthEngine::Poly));
+    setGlideTime((float)state.getProperty("glideTime", 0.1f));
+    setGlideConstantRate((bool)state.getProperty("glideConstantRate", false));
+    setNoiseSeed((juce::uint32)(juce::int64)state.getProperty("noiseSeed", 0));
+
+    // Fuera de tiempo real (render offline, reproduccion de capturas) la escala
+    // tiene que sonar desde el primer bloque
+    if (state.hasProperty("scala"))
+        tuning.loadScala(state["scala"].toString(), state["keyboardMapping"].toString(), isNonRealtime());
+    else
+        tuning.resetToEqualTemperament();
+
+    // Con todas las partes ya leidas: una sola reconstruccion de sonidos y zonas
+    multitimbral = (bool)state.getProperty("multitimbral", false);
+    rebuildPartSounds();
+
 }
 
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+SynthAudioProcessor::MemoryReport SynthAudioProcessor::getMemoryReport() const
 {
-    return new SynthAudioProcessor();
+    // No incluye los buffers internos de los efectos maestros, que reserva JUCE
+    MemoryReport report;
+    report.numVoices = getNumOscillatorVoices();
+    report.arenaBytes = arena.getCapacity();
+    report.arenaBytesPerVoice = arenaBytesPerVoice;
+    report.bytesPerVoice = sizeof(SynthVoice) + arenaBytesPerVoice;
+    report.bytesPerInstance = sizeof(SynthAudioProcessor) + arena.getCapacity() + sizeof(SynthVoice) * (size_t)report.numVoices;
+    return report;
 }
 
-void SynthAudioProcessor::setCurrentVolume(float volume)
+int SynthAudioProcessor::getNumOscillatorVoices() const
 {
-    currentVolume = volume;  // Establecer el valor de currentVolume
-    updateVolume(currentVolume);  // Propagar el cambio a las voces del sintetizador
+    int numVoices = 0;
+
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        if (dynamic_cast<SynthVoice*>(synth.getVoice(i)) != nullptr)
+            ++numVoices;
+
+    return numVoices;
 }
 
-void SynthAudioProcessor::updateVolume(float volume)
+bool SynthAudioProcessor::hasSoundingVoices() const
 {
     for (int i = 0; i < synth.getNumVoices(); ++i)
+        if (synth.getVoice(i)->isVoiceActive())
+            return true;
+
+    return false;
+}
+
+bool SynthAudioProcessor::loadSampleInstrument(const juce::Array<SampleZone>& zones)
+{
+    // Se carga en el hilo que llama: de cada muestra solo se lee el ataque
+    juce::ReferenceCountedArray<StreamingSamplerSound> newSounds;
+
+    for (auto& zone : zones)
+        if (auto sound = StreamingSamplerSound::create(formatManager, zone))
+            newSounds.add(sound);
+
+    if (newSounds.isEmpty())
+        return false;
+
+    removeSamplerSounds();
+
+    // El instrumento sustituye al oscilador
+    samplerSounds = newSounds;
+    rebuildPartSounds();
+    diskStreamer.start();
+    return true;
+}
+
+void SynthAudioProcessor::clearSampleInstrument()
+{
+    removeSamplerSounds();
+    rebuildPartSounds();
+}
+
+void SynthAudioProcessor::rebuildPartSounds()
+{
+    synth.allNotesOff(0, false);
+
+    // Con un instrumento de muestras cargado el oscilador no suena.
+    // Multitimbral: cada parte en su canal y zona. Si no, la parte 1 en todo el teclado.
+    juce::ReferenceCountedArray<juce::SynthesiserSound> newSounds;
+
+    for (auto* sound : samplerSounds)
+        newSounds.add(sound);
+
+    if (samplerSounds.isEmpty())
     {
-        if (auto voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
+        if (multitimbral)
         {
-            voice->setGain(volume);
+            for (auto& part : parts)
+                newSounds.add(new SynthSound(part, part.midiChannel, part.keyZone));
+        }
+        else
+        {
+            newSounds.add(new SynthSound(parts[0]));
         }
     }
+
+    synth.setSounds(std::move(newSounds));
 }
 
+void SynthAudioProcessor::setPartZone(int partIndex, int midiChannel, const KeyZone& zone)
+{
+    captureChange("setPartZone", { partIndex, midiChannel, zone.lowNote, zone.highNote, zone.lowVelocity, zone.highVelocity });
 
-void SynthAudioProcessor::setCurrentWaveform(int waveformType)
+    if (! juce::isPositiveAndBelow(partIndex, numParts))
+        return;
+
+    auto& part = parts[(size_t)partIndex];
+    part.midiChannel = juce::jlimit(0, 16, midiChannel);
+    part.keyZone = zone;
+    rebuildPartSounds();
+}
+
+void SynthAudioProcessor::setMultitimbral(bool shouldBeMultitimbral)
 {
-    currentWaveform = waveformType;
-    updateWaveformType(waveformType); // Propagar a voces
+    captureChange("setMultitimbral", { shouldBeMultitimbral });
+
+    if (multitimbral == shouldBeMultitimbral)
+        return;
+
+    multitimbral = shouldBeMultitimbral;
+
+    if (! multitimbral)
+        setEditedPart(0);
+
+    rebuildPartSounds();
 }
 
+void SynthAudioProcessor::setEditedPart(int partIndex)
+{
+    captureChange("setEditedPart", { partIndex });
+    editedPart = multitimbral ? juce::jlimit(0, numParts - 1, partIndex) : 0;
+
+    // El sampler no tiene partes: sigue los controles de la parte editada
+    updateVolume(getCurrentVolume());
+    updateADSR(getCurrentAttack(), getCurrentDecay(), getCurrentSustain(), getCurrentRelease());
+}
+
+void SynthAudioProcessor::removeSamplerSounds()
+{
+    // Los sonidos salen del sintetizador en el siguiente rebuildPartSounds
+    synth.allNotesOff(0, false);
+
+    // El hilo de disco puede tener aun punteros a los sonidos hasta atender la
+    // orden de parada: se retiran y solo se liberan cuando nadie los usa
+    retiredSamplerSounds.addArray(samplerSounds);
+    samplerSounds.clear();
+    releaseRetiredSamplerSounds();
+}
 
-void SynthAudioProcessor::updateWaveformType(int type)
+void SynthAudioProcessor::releaseRetiredSamplerSounds()
+{
+    // Una sola referencia = solo esta lista; ni voces ni sintetizador la tienen
+    for (int i = retiredSamplerSounds.size(); --i >= 0;)
+    {
+        auto* sound = retiredSamplerSounds.getObjectPointerUnchecked(i);
+
+        if (sound->getReferenceCount() == 1 && ! diskStreamer.isUsingSound(sound))
+            retiredSamplerSounds.remove(i);
+    }
+
+    if (retiredSamplerSounds.isEmpty())
+        retiredSoundsTimer.stopTimer();
+    else if (! retiredSoundsTimer.isTimerRunning())
+        retiredSoundsTimer.startTimer(100);
+}
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new SynthAudioProcessor();
+}
+
+void SynthAudioProcessor::setCurrentVolume(float volume)
+{
+    captureChange("setCurrentVolume", { volume });
+    auto& part = parts[(size_t)editedPart];
+    part.volume = volume;  // Las voces de la parte lo leen en el siguiente bloque
+    part.changed();
+    updateVolume(volume);  // Propagar el cambio a las voces del sampler
+}
+
+void SynthAudioProcessor::updateVolume(float volume)
 {
     for (int i = 0; i < synth.getNumVoices(); ++i)
     {
-        if (auto* voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
+        if (auto samplerVoice = dynamic_cast<StreamingSamplerVoice*>(synth.getVoice(i)))
         {
-            voice->setOscillatorWaveform(type);
+            samplerVoice->setGain(volume);
         }
     }
 }
 
 
+void SynthAudioProcessor::setCurrentWaveform(int waveformType)
+{
+    captureChange("setCurrentWaveform", { waveformType });
+    auto& part = parts[(size_t)editedPart];
+    part.waveform = waveformType;
+    part.changed();
+}
+
+
 
 void SynthAudioProcessor::setCurrentADSRParameters(float attack, float decay, float sustain, float release) {
 
-    currentAttack = attack;
-    currentDecay = decay;
-    currentSustain = sustain;
-    currentRelease = release;
+    captureChange("setCurrentADSRParameters", { attack, decay, sustain, release });
+
+    auto& part = parts[(size_t)editedPart];
+    part.attack = attack;
+    part.decay = decay;
+    part.sustain = sustain;
+    part.release = release;
+    part.changed();
 
-    updateADSR(attack, decay, sustain, release); // Actualizar ADSR en todas las voces
+    updateADSR(attack, decay, sustain, release); // Actualizar ADSR en las voces del sampler
 
 }
 void SynthAudioProcessor::updateADSR(float attack, float decay, float sustain, float release)
 {
-    // Actualizar los parmetros ADSR de todas las voces del sintetizador
+    // Las voces de oscilador leen el ADSR de su parte; solo falta el sampler
 
     for (int i = 0; i < synth.getNumVoices(); ++i)
     {
-        if (auto* voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
+        if (auto* samplerVoice = dynamic_cast<StreamingSamplerVoice*>(synth.getVoice(i)))
         {
-            juce::ADSR::Parameters adsrParams;
-            adsrParams.attack = attack;
-            adsrParams.decay = decay;
-            adsrParams.sustain = sustain;
-            adsrParams.release = release;
-            voice->getADSR().setParameters(adsrParams);
+            samplerVoice->setEnvelope({ attack, decay, sustain, release });
         }
     }
 }
 
+void SynthAudioProcessor::setCurrentReverbSend(float send)
+{
+    captureChange("setCurrentReverbSend", { send });
+    auto& part = parts[(size_t)editedPart];
+    part.reverbSend = send;
+    part.changed();
+}
+
+void SynthAudioProcessor::setCurrentWavetable(int index)
+{
+    captureChange("setCurrentWavetable", { index });
+    auto& part = parts[(size_t)editedPart];
+    part.wavetable = juce::jlimit(0, SharedDspResources::numWavetables - 1, index);
+    part.changed();
+}
+
+void SynthAudioProcessor::setCurrentWavetablePosition(float position)
+{
+    captureChange("setCurrentWavetablePosition", { position });
+    auto& part = parts[(size_t)editedPart];
+    part.wavetablePosition = juce::jlimit(0.0f, 1.0f, position);
+    part.changed();
+}
+
+void SynthAudioProcessor::setCurrentWavetableScan(float amount)
+{
+    captureChange("setCurrentWavetableScan", { amount });
+    auto& part = parts[(size_t)editedPart];
+    part.wavetableScan = juce::jlimit(-1.0f, 1.0f, amount);
+    part.changed();
+}
+
+void SynthAudioProcessor::setCurrentPan(float pan, float keyTracking, float spread)
+{
+    captureChange("setCurrentPan", { pan, keyTracking, spread });
+    auto& part = parts[(size_t)editedPart];
+    part.pan = juce::jlimit(-1.0f, 1.0f, pan);
+    part.panKeyTracking = juce::jlimit(-1.0f, 1.0f, keyTracking);
+    part.panSpread = juce::jlimit(0.0f, 1.0f, spread);
+    part.changed();
+}
+
+void SynthAudioProcessor::setCurrentDrift(float cents)
+{
+    captureChange("setCurrentDrift", { cents });
+    auto& part = parts[(size_t)editedPart];
+    part.drift = juce::jlimit(0.0f, 50.0f, cents);
+    part.changed();
+}
+
+void SynthAudioProcessor::setCurrentFmAlgorithm(int algorithm)
+{
+    captureChange("setCurrentFmAlgorithm", { algorithm });
+    auto& part = parts[(size_t)editedPart];
+    part.fmAlgorithm = juce::jlimit(0, FmOperators::numAlgorithms - 1, algorithm);
+    part.changed();
+}
+
+void SynthAudioProcessor::setCurrentFmFeedback(float feedback)
+{
+    captureChange("setCurrentFmFeedback", { feedback });
+    auto& part = parts[(size_t)editedPart];
+    part.fmFeedback = juce::jlimit(0.0f, 1.0f, feedback);
+    part.changed();
+}
+
+void SynthAudioProcessor::setCurrentFmOperator(int op, float ratio, float level, float attack, float decay, float sustain, float release)
+{
+    captureChange("setCurrentFmOperator", { op, ratio, level, attack, decay, sustain, release });
+
+    if (! juce::isPositiveAndBelow(op, FmOperators::numOperators))
+        return;
+
+    auto& part = parts[(size_t)editedPart];
+    auto& fmOperator = part.fmOperators[(size_t)op];
+    fmOperator.ratio = juce::jlimit(0.125f, 32.0f, ratio);
+    fmOperator.level = juce::jlimit(0.0f, 1.0f, level);
+    fmOperator.attack = attack;
+    fmOperator.decay = decay;
+    fmOperator.sustain = sustain;
+    fmOperator.release = release;
+    part.changed();
+}
+
 void SynthAudioProcessor::setCurrentReverbParameters(float roomSize, float damping, float wet, float dry, float width, float freeze)
 {
+    captureChange("setCurrentReverbParameters", { roomSize, damping, wet, dry, width, freeze });
     currentRoomSize = roomSize;
     currentDamping = damping;
     currentWetLevel = wet;
     currentDryLevel = dry;
     currentWidth = width;
     currentFreeze = freeze;
-    updateReverb(roomSize, damping, wet, dry, width, freeze); // Actualizar reverb en todas las voces
+    updateReverb(roomSize, damping, wet, dry, width, freeze); // Actualizar la reverb maestra
 }
 
 
 void SynthAudioProcessor::updateReverb(float roomSize, float damping, float wet, float dry, float width, float freeze)
 {
-    for (int i = 0; i < synth.getNumVoices(); ++i)
-    {
-        if (auto* voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
-        {
-            voice->setReverbParams(roomSize, damping, wet, dry, width, freeze);
-        }
-    }
+    effects.getReverb().setParameters(roomSize, damping, wet, dry, width, freeze);
 }
 
 void SynthAudioProcessor::setReverbEnabled(bool shouldEnable)
 {
-    reverbEnabled = shouldEnable;
-    setReverbEnabledForAllVoices(shouldEnable); // Propagar el cambio a todas las voces
+    captureChange("setReverbEnabled", { shouldEnable });
+    effects.setStageEnabled(MasterEffectChain::Reverb, shouldEnable);
 }
-void SynthAudioProcessor::setReverbEnabledForAllVoices(bool shouldEnable)
+
+void SynthAudioProcessor::setLimiterEnabled(bool shouldBeEnabled)
 {
-    for (int i = 0; i < synth.getNumVoices(); ++i)
-    {
-        if (auto* voice = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
-        {
-            voice->setReverbEnabled(shouldEnable);
-        }
-    }
-}
\ No newline at end of file
+    captureChange("setLimiterEnabled", { shouldBeEnabled });
+    limiter.setEnabled(shouldBeEnabled);
+    updateLatency();
+}
+
+void SynthAudioProcessor::setInternalBlockSize(int size, bool buffered)
+{
+    captureChange("setInternalBlockSize", { size, buffered });
+    internalBlockSize = size > 0 ? juce::jlimit(16, maxInternalBlockSize, juce::nextPowerOfTwo(size)) : 0;
+    internalBlockBuffered = buffered;
+    updateLatency();
+}
+
+void SynthAudioProcessor::updateLatency()
+{
+    if (getSampleRate() <= 0.0 || preparedBlockSize == 0)
+        return;
+
+    // El limitador desactivado no retrasa la senal: el host tiene que saberlo para compensar
+    const int requested = internalBlockSize.load();
+    setLatencySamples((limiter.isEnabled() ? MasterLimiter::getLatencySamples(getSampleRate()) : 0)
+                      + (requested > 0 && internalBlockBuffered.load() ? getChunkSize(requested) : 0));
+}
+
+void SynthAudioProcessor::setArpeggiatorMode(int mode)
+{
+    captureChange("setArpeggiatorMode", { mode });
+    arpeggiator.setMode(mode);
+}
+
+void SynthAudioProcessor::setArpeggiatorRate(int rate)
+{
+    captureChange("setArpeggiatorRate", { rate });
+    arpeggiator.setRate(rate);
+}
+
+void SynthAudioProcessor::loadTuning(const juce::String& sclText, const juce::String& kbmText)
+{
+    captureChange("loadTuning", { sclText, kbmText });
+    tuning.loadScala(sclText, kbmText, isNonRealtime());
+}
+
+void SynthAudioProcessor::loadTuningFiles(const juce::File& sclFile, const juce::File& kbmFile)
+{
+    // Se leen aqui para que la captura guarde el texto y no la ruta
+    loadTuning(sclFile.loadFileAsString(), kbmFile.existsAsFile() ? kbmFile.loadFileAsString() : juce::String());
+}
+
+void SynthAudioProcessor::captureChange(const char* setter, const juce::Array<juce::var>& arguments)
+{
+    if (capture.isCapturing() && ! restoringState)
+        capture.captureChange(setter, arguments);
+}
+
+bool SynthAudioProcessor::applyChange(const juce::String& setter, const juce::Array<juce::var>& arguments)
+{
+    // Los argumentos que falten valen 0
+    auto arg = [&arguments](int index) { return arguments[index]; };
+
+    if (setter == "setMultitimbral")                  setMultitimbral((bool)arg(0));
+    else if (setter == "setEditedPart")               setEditedPart((int)arg(0));
+    else if (setter == "setPartZone")                 setPartZone((int)arg(0), (int)arg(1), { (int)arg(2), (int)arg(3), (int)arg(4), (int)arg(5) });
+    else if (setter == "setCurrentVolume")            setCurrentVolume((float)arg(0));
+    else if (setter == "setCurrentWaveform")          setCurrentWaveform((int)arg(0));
+    else if (setter == "setCurrentADSRParameters")    setCurrentADSRParameters((float)arg(0), (float)arg(1), (float)arg(2), (float)arg(3));
+    else if (setter == "setCurrentReverbParameters")  setCurrentReverbParameters((float)arg(0), (float)arg(1), (float)arg(2), (float)arg(3), (float)arg(4), (float)arg(5));
+    else if (setter == "setReverbEnabled")            setReverbEnabled((bool)arg(0));
+    else if (setter == "setCurrentReverbSend")        setCurrentReverbSend((float)arg(0));
+    else if (setter == "setCurrentWavetable")         setCurrentWavetable((int)arg(0));
+    else if (setter == "setCurrentWavetablePosition") setCurrentWavetablePosition((float)arg(0));
+    else if (setter == "setCurrentWavetableScan")     setCurrentWavetableScan((float)arg(0));
+    else if (setter == "setCurrentPan")               setCurrentPan((float)arg(0), (float)arg(1), (float)arg(2));
+    else if (setter == "setCurrentDrift")             setCurrentDrift((float)arg(0));
+    else if (setter == "setCurrentFmAlgorithm")       setCurrentFmAlgorithm((int)arg(0));
+    else if (setter == "setCurrentFmFeedback")        setCurrentFmFeedback((float)arg(0));
+    else if (setter == "setCurrentFmOperator")        setCurrentFmOperator((int)arg(0), (float)arg(1), (float)arg(2), (float)arg(3), (float)arg(4), (float)arg(5), (float)arg(6));
+    else if (setter == "setPlayMode")                 setPlayMode((int)arg(0));
+    else if (setter == "setGlideTime")                setGlideTime((float)arg(0));
+    else if (setter == "setGlideConstantRate")        setGlideConstantRate((bool)arg(0));
+    else if (setter == "setLimiterEnabled")           setLimiterEnabled((bool)arg(0));
+    else if (setter == "setInternalBlockSize")        setInternalBlockSize((int)arg(0), (bool)arg(1));
+    else if (setter == "setNoiseSeed")                setNoiseSeed((juce::uint32)(juce::int64)arg(0));
+    else if (setter == "setArpeggiatorMode")          setArpeggiatorMode((int)arg(0));
+    else if (setter == "setArpeggiatorRate")          setArpeggiatorRate((int)arg(0));
+    else if (setter == "loadTuning")                  loadTuning(arg(0).toString(), arg(1).toString());
+    else return false;
+
+    return true;
+}
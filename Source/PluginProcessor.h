@@ -10,7 +10,20 @@
 
 #include <JuceHeader.h>
 #include "SynthVoice.h"
+#include "MasterEffectChain.h"
+#include "MasterLimiter.h"
+#include "QualityGovernor.h"
 #include "SynthSound.h"
+#include "SynthPart.h"
+#include "EffectSendBus.h"
+#include "SynthEngine.h"
+#include "Arpeggiator.h"
+#include "MicroTuning.h"
+#include "AnalyserFifo.h"
+#include "DspArena.h"
+#include "SessionCapture.h"
+#include "StreamingSampler.h"
+#include "TraceRecorder.h"
 
 //==============================================================================
 /**
@@ -54,48 +67,207 @@ public:
     //==============================================================================
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
+    // Partes del modo multitimbral: los metodos de volumen, forma de onda,
+    // ADSR y envio editan la parte seleccionada
+    static constexpr int numParts = 16;
+    void setMultitimbral(bool shouldBeMultitimbral);
+    bool isMultitimbral() const { return multitimbral; }
+    void setEditedPart(int partIndex);
+    int getEditedPart() const { return editedPart; }
+    // Canal MIDI (0 = todos) y zona de una parte: partes en el mismo canal con
+    // zonas separadas hacen un split y con zonas solapadas, capas
+    void setPartZone(int partIndex, int midiChannel, const KeyZone& zone);
     void updateVolume(float newVolume);
-    float getCurrentVolume() const { return currentVolume; }
+    float getCurrentVolume() const { return parts[(size_t)editedPart].volume.load(); }
     void setCurrentVolume(float volume);
 	//Esto es para cambiar el tipo de onda del oscilador
-    void updateWaveformType(int type);
-	int getCurrentWaveform() const { return currentWaveform; }
+	int getCurrentWaveform() const { return parts[(size_t)editedPart].waveform.load(); }
     void setCurrentWaveform(int waveformType);
 	// Mtodos para ADSR
     void setCurrentADSRParameters(float attack, float decay, float sustain, float release);
     void updateADSR(float attack, float decay, float sustain, float release);
-	float getCurrentAttack() const { return currentAttack; }
-	float getCurrentDecay() const { return currentDecay; }
-	float getCurrentSustain() const { return currentSustain; }
-	float getCurrentRelease() const { return currentRelease; }
-    // Metodos para Reverb
+	float getCurrentAttack() const { return parts[(size_t)editedPart].attack.load(); }
+	float getCurrentDecay() const { return parts[(size_t)editedPart].decay.load(); }
+	float getCurrentSustain() const { return parts[(size_t)editedPart].sustain.load(); }
+	float getCurrentRelease() const { return parts[(size_t)editedPart].release.load(); }
+    // Metodos para Reverb (bus maestro compartido por todas las partes)
     void updateReverb(float roomSize, float damping, float wet, float dry, float width, float freeze);
     void setCurrentReverbParameters(float roomSize, float damping, float wet, float dry, float width, float freeze);
 	void setReverbEnabled(bool shouldEnable);
-    void setReverbEnabledForAllVoices(bool shouldEnable);
+    void setCurrentReverbSend(float send);
+    float getCurrentReverbSend() const { return parts[(size_t)editedPart].reverbSend.load(); }
+    // Tabla con morphing de la parte editada (forma de onda 5)
+    void setCurrentWavetable(int index);
+    int getCurrentWavetable() const { return parts[(size_t)editedPart].wavetable.load(); }
+    void setCurrentWavetablePosition(float position);
+    float getCurrentWavetablePosition() const { return parts[(size_t)editedPart].wavetablePosition.load(); }
+    void setCurrentWavetableScan(float amount);
+    float getCurrentWavetableScan() const { return parts[(size_t)editedPart].wavetableScan.load(); }
+    // Panorama por voz de la parte editada: fijo, por nota y aleatorio (todos en -1..1)
+    void setCurrentPan(float pan, float keyTracking, float spread);
+    float getCurrentPan() const { return parts[(size_t)editedPart].pan.load(); }
+    float getCurrentPanKeyTracking() const { return parts[(size_t)editedPart].panKeyTracking.load(); }
+    float getCurrentPanSpread() const { return parts[(size_t)editedPart].panSpread.load(); }
+    // Deriva analogica de afinacion de la parte editada, en cents
+    void setCurrentDrift(float cents);
+    float getCurrentDrift() const { return parts[(size_t)editedPart].drift.load(); }
+    // Motor FM de la parte editada (forma de onda 4)
+    void setCurrentFmAlgorithm(int algorithm);
+    int getCurrentFmAlgorithm() const { return parts[(size_t)editedPart].fmAlgorithm.load(); }
+    void setCurrentFmFeedback(float feedback);
+    float getCurrentFmFeedback() const { return parts[(size_t)editedPart].fmFeedback.load(); }
+    void setCurrentFmOperator(int op, float ratio, float level, float attack, float decay, float sustain, float release);
+    const SynthPart::FmOperatorParameters& getCurrentFmOperator(int op) const { return parts[(size_t)editedPart].fmOperators[(size_t)op]; }
     float getCurrentRoomSize() { return currentRoomSize;}
     float getCurrentDamping() { return currentDamping;}
     float getCurrentWetLevel() { return currentWetLevel;}
     float getCurrentDryLevel() { return currentDryLevel;}
     float getCurrentWidth() { return currentWidth;}
     float getCurrentFreeze() { return currentFreeze;}
-	bool getReverbEnabled() const { return reverbEnabled; }
+	bool getReverbEnabled() const { return effects.isStageEnabled(MasterEffectChain::Reverb); }
+    // Modo de reproduccion (SynthEngine::PlayMode) y portamento
+    void setPlayMode(int mode) { captureChange("setPlayMode", { mode }); synth.setPlayMode(mode); }
+    int getPlayMode() const { return synth.getPlayMode(); }
+    void setGlideTime(float seconds) { captureChange("setGlideTime", { seconds }); synth.setGlideTime(seconds); }
+    float getGlideTime() const { return synth.getGlideTime(); }
+    void setGlideConstantRate(bool shouldUseConstantRate) { captureChange("setGlideConstantRate", { shouldUseConstantRate }); synth.setGlideConstantRate(shouldUseConstantRate); }
+    bool getGlideConstantRate() const { return synth.getGlideConstantRate(); }
+    // Cadena de efectos maestra (la reverb es una de sus etapas)
+    MasterEffectChain& getEffects() { return effects; }
+    // Limitador true peak de la salida maestra. Activarlo cambia la latencia reportada.
+    void setLimiterEnabled(bool shouldBeEnabled);
+    MasterLimiter& getLimiter() { return limiter; }
+    // Tamano de bloque interno fijo (0 = el del host; si no, potencia de dos de 16 a
+    // 256). Sin latencia los bloques del host se trocean y el ultimo trozo puede
+    // quedar corto; con buffered se acumulan y siempre se procesan trozos enteros,
+    // a cambio de reportar ese tamano como latencia.
+    void setInternalBlockSize(int size, bool buffered);
+    int getInternalBlockSize() const { return internalBlockSize.load(); }
+    bool getInternalBlockBuffered() const { return internalBlockBuffered.load(); }
+    // Calidad adaptativa segun la carga de CPU (ver QualityGovernor)
+    void setQualityGovernorEnabled(bool shouldBeEnabled) { governor.setEnabled(shouldBeEnabled); }
+    QualityGovernor& getQualityGovernor() { return governor; }
+    // Nivel fijo en lugar del del gobernador (-1 = sin fijar); replay() aplica el
+    // que tuvo cada bloque capturado
+    void setForcedQualityTier(int tier);
+    // Registro de eventos del hilo de audio; se vuelca solo si un bloque llega tarde
+    TraceRecorder& getTraceRecorder() { return trace; }
+    // Captura de MIDI, bloques y cambios de estado para reproducir una sesion offline
+    SessionCapture& getSessionCapture() { return capture; }
+    // Los setters se guardan en la captura con el bloque en el que entran y
+    // replay() los repite por su nombre. false si el setter no existe.
+    bool applyChange(const juce::String& setter, const juce::Array<juce::var>& arguments);
+    // Alguna voz suena ahora mismo. Desde el hilo de mensajes es solo una pista.
+    bool hasSoundingVoices() const;
+    // Memoria de las voces y buffers de la instancia, reservada en prepareToPlay
+    size_t getArenaBytes() const { return arena.getCapacity(); }
+    // Semilla del ruido de las voces; se aplica en el siguiente prepareToPlay para
+    // que un render offline con la misma semilla salga siempre igual
+    void setNoiseSeed(juce::uint32 seed) { captureChange("setNoiseSeed", { (juce::int64)seed }); noiseSeed = seed; }
+    juce::uint32 getNoiseSeed() const { return noiseSeed; }
+    // Afinacion de las voces de oscilador (12-TET o ficheros Scala)
+    MicroTuning& getTuning() { return tuning; }
+    // Fuera de tiempo real la escala se carga antes de volver
+    void loadTuning(const juce::String& sclText, const juce::String& kbmText);
+    void loadTuningFiles(const juce::File& sclFile, const juce::File& kbmFile);
+    // Arpegiador y secuenciador de pasos antes del sintetizador
+    Arpeggiator& getArpeggiator() { return arpeggiator; }
+    void setArpeggiatorMode(int mode);
+    void setArpeggiatorRate(int rate);
+    // Metodos para el analizador del editor
+    AnalyserFifo& getAnalyserFifo() { return analyserFifo; }
+    void setAnalyserActive(bool shouldBeActive) { analyserActive.store(shouldBeActive); }
+    double getAnalyserSampleRate() const { return getSampleRate() / analyserDecimation; }
+    // Informe de memoria del motor de audio
+    struct MemoryReport
+    {
+        int numVoices = 0;
+        size_t arenaBytes = 0;
+        size_t arenaBytesPerVoice = 0;
+        size_t bytesPerVoice = 0;
+        size_t bytesPerInstance = 0;
+    };
+    MemoryReport getMemoryReport() const;
+    // Metodos para el sampler por streaming
+    bool loadSampleInstrument(const juce::Array<SampleZone>& zones);
+    void clearSampleInstrument();
+    int getNumSamplerUnderruns() const { return diskStreamer.getNumUnderruns(); }
 
     
 
 
 private:
-    juce::Synthesiser synth;
+    void pushToAnalyser(const juce::AudioBuffer<float>& buffer);
+    void removeSamplerSounds();
+    void releaseRetiredSamplerSounds();
+    void rebuildPartSounds();
+    int getNumOscillatorVoices() const;
+    void renderChunk(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi, int startSample, int numSamples);
+    void processBuffered(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi, int chunkSize);
+    int getChunkSize(int requested) const { return requested > 0 ? juce::jmin(requested, preparedBlockSize) : preparedBlockSize; }
+    void updateLatency();
+    void applyQualityTier(int tier);
+    void traceBlockStart(const juce::MidiBuffer& midi, int numSamples) noexcept;
+    void traceBlockEnd(double seconds, int numSamples) noexcept;
+    void captureChange(const char* setter, const juce::Array<juce::var>& arguments);
 
+    static constexpr int numOscillatorVoices = 64;
+    static constexpr int numSamplerVoices = 16;
+    static constexpr int maxInternalBlockSize = 256;
 
-    float currentVolume = 0.5f;
+    // Declarada antes que el sintetizador: las voces la usan hasta destruirse
+    MicroTuning tuning;
+    // Tambien antes: el motor guarda un puntero al registro
+    TraceRecorder trace;
+    SynthEngine synth;
+    DspArena arena;
+    size_t arenaBytesPerVoice = 0;
 
-    int currentWaveform = 0;
+    std::array<SynthPart, numParts> parts;
+    int editedPart = 0;
+    bool multitimbral = false;
+
+    Arpeggiator arpeggiator;
+    juce::uint32 noiseSeed = 0;
+
+    EffectSendBus sendBus;
+    MasterEffectChain effects;
+    MasterLimiter limiter;
+
+    QualityGovernor governor;
+    int appliedQualityTier = QualityGovernor::Full;
+    std::atomic<int> forcedQualityTier{ -1 };
+    std::array<juce::uint32, numParts> tracedPartVersions{};
+    SessionCapture capture{ *this };
+    // setStateInformation se captura entero y no setter a setter
+    bool restoringState = false;
+
+    std::atomic<int> internalBlockSize{ 0 };
+    std::atomic<bool> internalBlockBuffered{ false };
+    int preparedBlockSize = 0;
+    // Modo con latencia: el trozo ya renderizado que se va entregando mientras se
+    // acumula el MIDI del siguiente
+    juce::AudioBuffer<float> chunkBuffer;
+    juce::MidiBuffer chunkMidi;
+    int bufferedChunkSize = 0;
+    int bufferedFill = 0;
+
+    juce::AudioFormatManager formatManager;
+    juce::ReferenceCountedArray<StreamingSamplerSound> samplerSounds;
+    juce::ReferenceCountedArray<StreamingSamplerSound> retiredSamplerSounds;
+    // Declarado despues de los sonidos para que el hilo pare antes de liberarlos
+    DiskStreamer diskStreamer{ numSamplerVoices };
+    // Reintenta liberar los sonidos retirados mientras alguno siga en uso
+    juce::TimedCallback retiredSoundsTimer{ [this] { releaseRetiredSamplerSounds(); } };
+
+    AnalyserFifo analyserFifo;
+    std::atomic<bool> analyserActive{ false };
+    int analyserDecimation = 1;
+    int analyserDecimationCount = 0;
+    float analyserAccumulator = 0.0f;
+    float* analyserScratch = nullptr;
+    int analyserScratchSize = 0;
 
-	float currentAttack = 0.1f;
-	float currentDecay = 0.1f;
-	float currentSustain = 1.0f;
-	float currentRelease = 0.4f;
 
 	float currentRoomSize = 0.5f;
 	float currentDamping = 0.5f;
@@ -103,7 +275,6 @@ private:
 	float currentDryLevel = 0.7f;
 	float currentWidth = 1.0f;
 	float currentFreeze = 0.0f;
-	bool reverbEnabled = true;
 
 
     
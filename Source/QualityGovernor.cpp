@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.cpp
+    Created: 19 Oct 2026 11:34:02pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "QualityGovernor.h"
+
+const char* QualityGovernor::getTierName(int tierIndex)
+{
+    static const char* names[] = { "Full", "Limiter Peak", "Reverb Mono", "32 Voices", "16 Voices" };
+    return names[juce::jlimit(0, (int)numTiers - 1, tierIndex)];
+}
+
+void QualityGovernor::prepare(double newSampleRate, int maxBlockSize)
+{
+    sampleRate = newSampleRate;
+    loadMeasurer.reset(sampleRate, maxBlockSize);
+    samplesOverloaded = 0;
+    samplesRelaxed = 0;
+}
+
+int QualityGovernor::update(int numSamples, bool isRealtime) noexcept
+{
+    if (! isEnabled() || ! isRealtime)
+    {
+        samplesOverloaded = 0;
+        samplesRelaxed = 0;
+        tier.store(Full, std::memory_order_relaxed);
+        return Full;
+    }
+
+    const auto load = (float)loadMeasurer.getLoadAsProportion();
+    auto current = tier.load(std::memory_order_relaxed);
+
+    samplesOverloaded = load > stepDownLoad ? samplesOverloaded + numSamples : 0;
+    samplesRelaxed = load < stepUpLoad ? samplesRelaxed + numSamples : 0;
+
+    // Un escalon cada vez; tras cada cambio se vuelve a esperar antes del siguiente
+    if (samplesOverloaded >= (int)(stepDownSeconds * sampleRate) && current < numTiers - 1)
+    {
+        ++current;
+        samplesOverloaded = 0;
+        samplesRelaxed = 0;
+    }
+    else if (samplesRelaxed >= (int)(stepUpSeconds * sampleRate) && current > Full)
+    {
+        --current;
+        samplesOverloaded = 0;
+        samplesRelaxed = 0;
+    }
+
+    tier.store(current, std::memory_order_relaxed);
+    return current;
+}
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+	QualityGovernor.h
+	Created: 19 Oct 2026 11:34:02pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Baja la calidad por escalones cuando processBlock se acerca al limite de
+// tiempo real y la recupera cuando vuelve a haber margen. Para bajar la carga
+// tiene que seguir alta un rato corto; para subir, baja durante bastante mas
+// (histeresis), asi no oscila entre dos niveles.
+class QualityGovernor {
+
+public:
+	// Cada nivel incluye los anteriores
+	enum Tier {
+		Full = 0,
+		LimiterSamplePeak,		// limitador sin sobremuestreo: pico de muestra
+		ReverbMono,				// reverb maestra en mono
+		Polyphony32,			// como mucho 32 voces sonando, colas incluidas
+		Polyphony16,			// como mucho 16
+		numTiers
+	};
+
+	static constexpr float stepDownLoad = 0.85f;
+	static constexpr float stepUpLoad = 0.5f;
+	static constexpr double stepDownSeconds = 0.25;
+	static constexpr double stepUpSeconds = 3.0;
+
+	static const char* getTierName(int tier);
+
+	void prepare(double sampleRate, int maxBlockSize);
+
+	// Hilo de audio: el ScopedTimer de cada processBlock mide sobre esto
+	juce::AudioProcessLoadMeasurer& getLoadMeasurer() noexcept { return loadMeasurer; }
+	// Hilo de audio, una vez por bloque antes de procesarlo. Devuelve el nivel a aplicar.
+	// Fuera de tiempo real (bounce, render offline) no hay limite que cumplir: siempre Full.
+	int update(int numSamples, bool isRealtime) noexcept;
+
+	void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+	bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+	// El estado guarda el nivel solo para diagnostico ("qualityTier"); al cargarlo
+	// no se restaura: cada sesion empieza en Full
+	int getTier() const noexcept { return tier.load(std::memory_order_relaxed); }
+	// Carga suavizada: tiempo de proceso / duracion del bloque
+	float getLoad() const { return (float)loadMeasurer.getLoadAsProportion(); }
+
+private:
+	juce::AudioProcessLoadMeasurer loadMeasurer;
+	double sampleRate = 44100.0;
+	int samplesOverloaded = 0;
+	int samplesRelaxed = 0;
+
+	std::atomic<bool> enabled{ true };
+	std::atomic<int> tier{ Full };
+
+};
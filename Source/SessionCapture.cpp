@@ -0,0 +1,654 @@
+/*
+  ==============================================================================
+
+    SessionCapture.cpp
+    Created: 20 Oct 2026 12:12:40am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "SessionCapture.h"
+#include "PluginProcessor.h"
+
+namespace
+{
+    constexpr int captureMagic = 0x50414353;    // "SCAP"
+    // La version 1 no guardaba el nivel de calidad ni los setters
+    constexpr int captureVersion = 2;
+    constexpr int flagStartedMidSession = 1;
+
+    enum RecordType : juce::uint8 {
+        RecordPrepare = 'P',        // f64 frecuencia, i32 bloque
+        RecordBlockStart = 'B',     // i32 muestras, u8 flags, u8 nivel de calidad, f64 bpm, f64 ppq, i32 eventos, eventos (i32 posicion, u16 bytes, datos)
+        RecordBlockEnd = 'E',       // f32 segundos, f32 pico de salida
+        RecordState = 'S',          // i64 bloque, i32 bytes, datos de setStateInformation
+        RecordSetter = 'C',         // i64 bloque, var [setter, argumentos...] de juce::var::writeToStream
+        RecordOverflow = 'X'        // la cola se lleno y la captura se corto aqui
+    };
+
+    enum BlockFlags : juce::uint8 {
+        hasBpm = 1,
+        hasPpq = 2,
+        isPlaying = 4
+    };
+
+    // Escribe campos en little endian sobre memoria ya reservada, sin pasarse de capacity
+    struct RecordWriter
+    {
+        char* data;
+        int capacity;
+        int size = 0;
+
+        bool fits(int bytes) const noexcept { return size + bytes <= capacity; }
+
+        void addBytes(const void* source, int bytes) noexcept
+        {
+            if (fits(bytes))
+                std::memcpy(data + size, source, (size_t)bytes);
+            size += bytes;
+        }
+
+        void addByte(juce::uint8 value) noexcept { addBytes(&value, 1); }
+        void addShort(juce::uint16 value) noexcept { value = juce::ByteOrder::swapIfBigEndian(value); addBytes(&value, 2); }
+        void addInt(juce::int32 value) noexcept { auto bits = juce::ByteOrder::swapIfBigEndian((juce::uint32)value); addBytes(&bits, 4); }
+
+        void addFloat(float value) noexcept
+        {
+            juce::uint32 bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            addInt((juce::int32)bits);
+        }
+
+        void addDouble(double value) noexcept
+        {
+            juce::uint64 bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            bits = juce::ByteOrder::swapIfBigEndian(bits);
+            addBytes(&bits, 8);
+        }
+
+        // Se escribio todo lo pedido
+        bool isComplete() const noexcept { return size <= capacity; }
+    };
+
+    // Posicion del host capturada, bloque a bloque
+    class ReplayPlayHead : public juce::AudioPlayHead {
+
+    public:
+        const SessionCapture::Session::Block* block = nullptr;
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            if (block == nullptr)
+                return {};
+
+            PositionInfo info;
+            info.setIsPlaying(block->isPlaying);
+
+            if (block->bpm.has_value())
+                info.setBpm(*block->bpm);
+            if (block->ppqPosition.has_value())
+                info.setPpqPosition(*block->ppqPosition);
+
+            return info;
+        }
+
+    };
+}
+
+SessionCapture::SessionCapture(SynthAudioProcessor& ownerToUse)
+    : juce::Thread("Session capture"),
+      owner(ownerToUse)
+{
+}
+
+SessionCapture::~SessionCapture()
+{
+    stop();
+}
+
+bool SessionCapture::start(const juce::File& fileToWrite)
+{
+    stop();
+
+    fileToWrite.getParentDirectory().createDirectory();
+    fileToWrite.deleteFile();
+    auto newStream = std::make_unique<juce::FileOutputStream>(fileToWrite);
+
+    if (! newStream->openedOk())
+        return false;
+
+    // La cola solo ocupa memoria en las instancias que capturan: se reserva
+    // aqui, en el hilo de mensajes, la primera vez que se captura
+    if (fifoData == nullptr)
+    {
+        fifoData.allocate((size_t)fifoBytes, false);
+        scratch.allocate((size_t)maxBlockRecordBytes, false);
+    }
+
+    // Lo que quedase en la cola de la captura anterior se descarta
+    while (fifo.getNumReady() > 0)
+        fifo.read(fifo.getNumReady());
+
+    // Estado completo de ahora: la reproduccion empieza exactamente desde aqui
+    juce::MemoryBlock initialState;
+    owner.getStateInformation(initialState);
+
+    newStream->writeInt(captureMagic);
+    newStream->writeInt(captureVersion);
+    newStream->writeInt(owner.hasSoundingVoices() ? flagStartedMidSession : 0);
+    newStream->writeDouble(owner.getSampleRate() > 0.0 ? owner.getSampleRate() : 44100.0);
+    newStream->writeInt(juce::jmax(1, owner.getBlockSize()));
+    newStream->writeInt(owner.getTotalNumOutputChannels());
+    newStream->writeInt((int)initialState.getSize());
+    newStream->write(initialState.getData(), initialState.getSize());
+
+    stream = std::move(newStream);
+    file = fileToWrite;
+    pendingChanges.clear();
+    blocksCaptured = 0;
+    blockOpen = false;
+    overflowed = false;
+
+    startThread(juce::Thread::Priority::low);
+    active = true;
+    return true;
+}
+
+void SessionCapture::stop()
+{
+    if (stream == nullptr)
+        return;
+
+    active = false;
+    // El hilo escribe lo que quede en la cola antes de terminar
+    stopThread(2000);
+
+    if (overflowed.load())
+        stream->writeByte((char)RecordOverflow);
+
+    stream->flush();
+    stream.reset();
+}
+
+bool SessionCapture::push(const char* data, int size) noexcept
+{
+    if (fifo.getFreeSpace() < size)
+        return false;
+
+    const auto scope = fifo.write(size);
+
+    if (scope.blockSize1 > 0)
+        std::memcpy(fifoData.get() + scope.startIndex1, data, (size_t)scope.blockSize1);
+    if (scope.blockSize2 > 0)
+        std::memcpy(fifoData.get() + scope.startIndex2, data + scope.blockSize1, (size_t)scope.blockSize2);
+
+    return true;
+}
+
+void SessionCapture::capturePrepare(double sampleRate, int blockSize) noexcept
+{
+    if (! active.load(std::memory_order_acquire) || overflowed.load(std::memory_order_relaxed))
+        return;
+
+    RecordWriter writer{ scratch.get(), maxBlockRecordBytes };
+    writer.addByte(RecordPrepare);
+    writer.addDouble(sampleRate);
+    writer.addInt(blockSize);
+
+    if (! push(scratch.get(), writer.size))
+        overflowed = true;
+}
+
+void SessionCapture::captureBlockStart(const juce::MidiBuffer& midi, int numSamples, juce::AudioPlayHead* playHead, int qualityTier) noexcept
+{
+    blockOpen = false;
+
+    if (! active.load(std::memory_order_acquire) || overflowed.load(std::memory_order_relaxed))
+        return;
+
+    juce::uint8 flags = 0;
+    double bpm = 0.0;
+    double ppq = 0.0;
+
+    if (playHead != nullptr)
+    {
+        if (auto position = playHead->getPosition())
+        {
+            if (auto hostBpm = position->getBpm())
+            {
+                flags |= hasBpm;
+                bpm = *hostBpm;
+            }
+
+            if (auto hostPpq = position->getPpqPosition())
+            {
+                flags |= hasPpq;
+                ppq = *hostPpq;
+            }
+
+            if (position->getIsPlaying())
+                flags |= isPlaying;
+        }
+    }
+
+    RecordWriter writer{ scratch.get(), maxBlockRecordBytes };
+    writer.addByte(RecordBlockStart);
+    writer.addInt(numSamples);
+    writer.addByte(flags);
+    writer.addByte((juce::uint8)qualityTier);
+    writer.addDouble(bpm);
+    writer.addDouble(ppq);
+    writer.addInt(midi.getNumEvents());
+
+    for (const auto metadata : midi)
+    {
+        writer.addInt(metadata.samplePosition);
+        writer.addShort((juce::uint16)juce::jmin(metadata.numBytes, 0xffff));
+        writer.addBytes(metadata.data, juce::jmin(metadata.numBytes, 0xffff));
+    }
+
+    // Un bloque que no cabe entero no se escribe a medias: la captura acaba aqui
+    if (! writer.isComplete() || ! push(scratch.get(), writer.size))
+    {
+        overflowed = true;
+        return;
+    }
+
+    blocksCaptured.fetch_add(1, std::memory_order_release);
+    blockOpen = true;
+}
+
+void SessionCapture::captureBlockEnd(double seconds, const juce::AudioBuffer<float>& output) noexcept
+{
+    if (! blockOpen)
+        return;
+
+    blockOpen = false;
+    float peak = 0.0f;
+
+    for (int channel = 0; channel < output.getNumChannels(); ++channel)
+        peak = juce::jmax(peak, output.getMagnitude(channel, 0, output.getNumSamples()));
+
+    RecordWriter writer{ scratch.get(), maxBlockRecordBytes };
+    writer.addByte(RecordBlockEnd);
+    writer.addFloat((float)seconds);
+    writer.addFloat(peak);
+
+    if (! push(scratch.get(), writer.size))
+        overflowed = true;
+}
+
+void SessionCapture::captureChange(const juce::String& setter, const juce::Array<juce::var>& arguments)
+{
+    Session::Change change;
+    change.setter = setter;
+    change.arguments = arguments;
+    addChange(std::move(change));
+}
+
+void SessionCapture::captureState(const void* data, int sizeInBytes)
+{
+    Session::Change change;
+    change.state.append(data, (size_t)juce::jmax(0, sizeInBytes));
+    addChange(std::move(change));
+}
+
+void SessionCapture::addChange(Session::Change change)
+{
+    if (! isCapturing())
+        return;
+
+    // El procesador lee sus parametros al empezar cada bloque: el cambio se ve
+    // en el primero que aun no ha empezado
+    change.beforeBlock = blocksCaptured.load(std::memory_order_acquire);
+
+    const juce::ScopedLock sl(changeLock);
+    pendingChanges.push_back(std::move(change));
+}
+
+void SessionCapture::drain()
+{
+    const auto scope = fifo.read(fifo.getNumReady());
+
+    if (scope.blockSize1 > 0)
+        stream->write(fifoData.get() + scope.startIndex1, (size_t)scope.blockSize1);
+    if (scope.blockSize2 > 0)
+        stream->write(fifoData.get() + scope.startIndex2, (size_t)scope.blockSize2);
+
+    std::vector<Session::Change> changes;
+    {
+        const juce::ScopedLock sl(changeLock);
+        changes.swap(pendingChanges);
+    }
+
+    for (const auto& change : changes)
+        writeChange(change);
+}
+
+void SessionCapture::writeChange(const Session::Change& change)
+{
+    if (change.setter.isEmpty())
+    {
+        stream->writeByte((char)RecordState);
+        stream->writeInt64(change.beforeBlock);
+        stream->writeInt((int)change.state.getSize());
+        stream->write(change.state.getData(), change.state.getSize());
+        return;
+    }
+
+    juce::Array<juce::var> call;
+    call.add(change.setter);
+    call.addArray(change.arguments);
+
+    stream->writeByte((char)RecordSetter);
+    stream->writeInt64(change.beforeBlock);
+    juce::var(call).writeToStream(*stream);
+}
+
+void SessionCapture::run()
+{
+    while (! threadShouldExit())
+    {
+        wait(50);
+        drain();
+    }
+
+    drain();
+}
+
+//==============================================================================
+bool SessionCapture::load(const juce::File& fileToRead, Session& session, juce::String& error)
+{
+    juce::MemoryBlock data;
+
+    if (! fileToRead.loadFileAsData(data))
+    {
+        error = "No se pudo leer " + fileToRead.getFullPathName();
+        return false;
+    }
+
+    juce::MemoryInputStream in(data, false);
+
+    const auto magic = in.readInt();
+    const auto version = in.readInt();
+
+    if (magic != captureMagic || version < 1 || version > captureVersion)
+    {
+        error = "No es una captura de sesion";
+        return false;
+    }
+
+    session = {};
+    session.startedMidSession = (in.readInt() & flagStartedMidSession) != 0;
+    session.sampleRate = in.readDouble();
+    session.blockSize = in.readInt();
+    session.numChannels = in.readInt();
+
+    const auto stateSize = in.readInt();
+
+    if (stateSize < 0 || stateSize > in.getNumBytesRemaining() || session.sampleRate <= 0.0 || session.numChannels <= 0)
+    {
+        error = "Cabecera danada";
+        return false;
+    }
+
+    in.readIntoMemoryBlock(session.initialState, stateSize);
+
+    // Un registro cortado al final (captura interrumpida) se ignora
+    while (! in.isExhausted())
+    {
+        const auto type = (juce::uint8)in.readByte();
+        const auto remaining = in.getNumBytesRemaining();
+
+        if (type == RecordBlockStart && remaining >= (version >= 2 ? 26 : 25))
+        {
+            Session::Block block;
+            block.numSamples = in.readInt();
+            const auto flags = (juce::uint8)in.readByte();
+
+            if (version >= 2)
+                block.qualityTier = (juce::uint8)in.readByte();
+
+            const auto bpm = in.readDouble();
+            const auto ppq = in.readDouble();
+            const auto numEvents = in.readInt();
+
+            block.isPlaying = (flags & isPlaying) != 0;
+            if ((flags & hasBpm) != 0)
+                block.bpm = bpm;
+            if ((flags & hasPpq) != 0)
+                block.ppqPosition = ppq;
+
+            bool truncated = false;
+
+            for (int i = 0; i < numEvents && ! truncated; ++i)
+            {
+                const auto position = in.readInt();
+                const auto numBytes = (int)(juce::uint16)in.readShort();
+                juce::HeapBlock<juce::uint8> bytes((size_t)juce::jmax(1, numBytes));
+
+                truncated = in.read(bytes.get(), numBytes) != numBytes;
+
+                if (! truncated)
+                    block.midi.addEvent(bytes.get(), numBytes, position);
+            }
+
+            if (truncated || block.numSamples <= 0)
+                break;
+
+            session.blocks.push_back(std::move(block));
+        }
+        else if (type == RecordBlockEnd && remaining >= 8)
+        {
+            const auto seconds = in.readFloat();
+            const auto peak = in.readFloat();
+
+            if (! session.blocks.empty())
+            {
+                session.blocks.back().seconds = seconds;
+                session.blocks.back().outputPeak = peak;
+            }
+        }
+        else if (type == RecordPrepare && remaining >= 12)
+        {
+            Session::Prepare prepare;
+            prepare.beforeBlock = (juce::int64)session.blocks.size();
+            prepare.sampleRate = in.readDouble();
+            prepare.blockSize = in.readInt();
+            session.prepares.push_back(prepare);
+        }
+        else if (type == RecordState && remaining >= 12)
+        {
+            Session::Change change;
+            change.beforeBlock = in.readInt64();
+            const auto size = in.readInt();
+
+            if (size < 0 || size > in.getNumBytesRemaining())
+                break;
+
+            in.readIntoMemoryBlock(change.state, size);
+            session.changes.push_back(std::move(change));
+        }
+        else if (type == RecordSetter && remaining >= 9)
+        {
+            Session::Change change;
+            change.beforeBlock = in.readInt64();
+            const auto call = juce::var::readFromStream(in);
+
+            if (! call.isArray() || call.size() == 0 || ! call[0].isString())
+                break;
+
+            change.setter = call[0].toString();
+
+            for (int i = 1; i < call.size(); ++i)
+                change.arguments.add(call[i]);
+
+            session.changes.push_back(std::move(change));
+        }
+        else if (type == RecordOverflow)
+        {
+            session.incomplete = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // Los cambios del mismo bloque quedan en el orden en que se hicieron
+    std::stable_sort(session.changes.begin(), session.changes.end(),
+                     [](const auto& a, const auto& b) { return a.beforeBlock < b.beforeBlock; });
+    return true;
+}
+
+SessionCapture::ReplayResult SessionCapture::replay(const Session& session, const juce::File& outputFile)
+{
+    ReplayResult result;
+    SynthAudioProcessor processor;
+    ReplayPlayHead playHead;
+
+    // Antes de cargar el estado: sin tiempo real la afinacion Scala se carga en
+    // el momento y no en su hilo, asi que el primer bloque ya suena afinado
+    processor.setNonRealtime(true);
+
+    if (session.initialState.getSize() > 0)
+        processor.setStateInformation(session.initialState.getData(), (int)session.initialState.getSize());
+
+    double sampleRate = session.sampleRate;
+    processor.setRateAndBufferSizeDetails(sampleRate, session.blockSize);
+    processor.prepareToPlay(sampleRate, session.blockSize);
+    processor.setPlayHead(&playHead);
+
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+
+    if (outputFile != juce::File())
+    {
+        juce::WavAudioFormat wav;
+        outputFile.deleteFile();
+        auto outputStream = std::make_unique<juce::FileOutputStream>(outputFile);
+
+        if (outputStream->openedOk())
+            writer.reset(wav.createWriterFor(outputStream.get(), sampleRate, (unsigned int)session.numChannels, 32, {}, 0));
+        if (writer != nullptr)
+            outputStream.release();
+    }
+
+    int maxBlockSamples = session.blockSize;
+    for (const auto& block : session.blocks)
+        maxBlockSamples = juce::jmax(maxBlockSamples, block.numSamples);
+
+    juce::AudioBuffer<float> buffer(session.numChannels, maxBlockSamples);
+    juce::MidiBuffer midi;
+    size_t nextChange = 0;
+    size_t nextPrepare = 0;
+    int unknownChanges = 0;
+
+    for (size_t index = 0; index < session.blocks.size(); ++index)
+    {
+        const auto& block = session.blocks[index];
+
+        // Mismo orden que en la sesion: primero los prepareToPlay, luego los cambios
+        while (nextPrepare < session.prepares.size() && session.prepares[nextPrepare].beforeBlock <= (juce::int64)index)
+        {
+            const auto& prepare = session.prepares[nextPrepare++];
+            sampleRate = prepare.sampleRate;
+            processor.setRateAndBufferSizeDetails(sampleRate, prepare.blockSize);
+            processor.prepareToPlay(sampleRate, prepare.blockSize);
+        }
+
+        while (nextChange < session.changes.size() && session.changes[nextChange].beforeBlock <= (juce::int64)index)
+        {
+            const auto& change = session.changes[nextChange++];
+
+            if (change.setter.isEmpty())
+                processor.setStateInformation(change.state.getData(), (int)change.state.getSize());
+            else if (! processor.applyChange(change.setter, change.arguments))
+                ++unknownChanges;
+        }
+
+        // El nivel de calidad que tuvo el bloque, no el que daria la carga de
+        // ahora; las capturas antiguas no lo guardan y van con calidad completa
+        processor.setForcedQualityTier(block.qualityTier >= 0 ? block.qualityTier : QualityGovernor::Full);
+
+        buffer.setSize(session.numChannels, block.numSamples, false, false, true);
+        buffer.clear();
+        midi = block.midi;
+        playHead.block = &block;
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        processor.processBlock(buffer, midi);
+        const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+        const auto blockDuration = (double)block.numSamples / sampleRate;
+        result.renderSeconds += seconds;
+        result.replayOverruns += seconds > blockDuration ? 1 : 0;
+
+        if (seconds > result.slowestBlockSeconds)
+        {
+            result.slowestBlockSeconds = seconds;
+            result.slowestBlock = (int)index;
+        }
+
+        if (block.seconds >= 0.0f)
+        {
+            result.capturedSeconds += block.seconds;
+            result.capturedOverruns += block.seconds > blockDuration ? 1 : 0;
+        }
+
+        // Sin el audio capturado, el pico por bloque basta para ver donde se separan
+        if (block.outputPeak >= 0.0f)
+        {
+            float peak = 0.0f;
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                peak = juce::jmax(peak, buffer.getMagnitude(channel, 0, block.numSamples));
+
+            const auto error = std::abs(peak - block.outputPeak);
+            result.maxPeakError = juce::jmax(result.maxPeakError, error);
+
+            if (error > 1.0e-5f && result.firstMismatchBlock < 0)
+                result.firstMismatchBlock = (int)index;
+        }
+
+        if (writer != nullptr)
+            writer->writeFromAudioSampleBuffer(buffer, 0, block.numSamples);
+    }
+
+    processor.setPlayHead(nullptr);
+    processor.releaseResources();
+
+    result.numBlocks = (int)session.blocks.size();
+
+    if (session.incomplete)
+        result.message = "Captura incompleta: la cola se lleno";
+    else if (session.startedMidSession)
+        result.message = "Captura empezada con notas sonando: esas notas no se reproducen";
+    else if (unknownChanges > 0)
+        result.message = juce::String(unknownChanges) + " cambios con setters desconocidos no se reprodujeron";
+
+    return result;
+}
+
+juce::String SessionCapture::formatReport(const ReplayResult& result)
+{
+    juce::String report;
+
+    report << juce::String(result.numBlocks) << " bloques, " << juce::String(result.renderSeconds * 1000.0, 1) << " ms"
+           << " (captura " << juce::String(result.capturedSeconds * 1000.0, 1) << " ms)" << juce::newLine
+           << "Bloques tarde: " << juce::String(result.replayOverruns) << " (captura " << juce::String(result.capturedOverruns) << ")"
+           << ", el mas lento #" << juce::String(result.slowestBlock) << " con " << juce::String(result.slowestBlockSeconds * 1000.0, 2) << " ms"
+           << juce::newLine;
+
+    if (result.firstMismatchBlock >= 0)
+        report << "La salida se separa en el bloque #" << juce::String(result.firstMismatchBlock);
+    else
+        report << "Salida igual a la capturada";
+
+    report << " (error de pico maximo " << juce::String(result.maxPeakError, 6) << ")" << juce::newLine;
+
+    if (result.message.isNotEmpty())
+        report << result.message << juce::newLine;
+
+    return report;
+}
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+	SessionCapture.h
+	Created: 20 Oct 2026 12:12:40am
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class SynthAudioProcessor;
+
+// Captura de una sesion para reproducir cortes offline: el estado inicial, cada
+// bloque con su tamano, sus eventos MIDI, la posicion del host y el nivel de
+// calidad aplicado, el tiempo que tardo y el pico de salida, y cada llamada a un
+// setter del procesador o setStateInformation con el bloque en el que entra. El
+// hilo de audio solo copia a una cola sin bloqueos; un hilo aparte escribe el
+// fichero binario. replay() vuelve a pasar la captura por
+// SynthAudioProcessor::processBlock con los mismos bloques, niveles y cambios.
+//
+// Formato (little endian): cabecera con magic, version, flags, frecuencia,
+// bloque, canales y estado inicial; despues registros de un byte de tipo
+// seguido de sus campos (ver los Record* del .cpp).
+class SessionCapture : private juce::Thread {
+
+public:
+	static constexpr int fifoBytes = 1 << 22;
+	// Un bloque con mas MIDI que esto no cabe y rompe la captura
+	static constexpr int maxBlockRecordBytes = 1 << 16;
+
+	explicit SessionCapture(SynthAudioProcessor& owner);
+	~SessionCapture() override;
+
+	// Hilo de mensajes. La captura empieza con el estado completo y el formato
+	// actuales, asi que se puede armar en cualquier momento; solo se marca a
+	// mitad de sesion si habia voces sonando, porque esas notas no se reproducen.
+	bool start(const juce::File& file);
+	void stop();
+	bool isCapturing() const noexcept { return active.load(std::memory_order_relaxed); }
+	juce::File getFile() const { return file; }
+
+	// Hilo de mensajes: un setter del procesador con sus argumentos, o un estado
+	// completo cargado por el host. Se guardan en orden con el bloque siguiente.
+	void captureChange(const juce::String& setter, const juce::Array<juce::var>& arguments);
+	void captureState(const void* data, int sizeInBytes);
+
+	// Hilo de audio
+	void capturePrepare(double sampleRate, int blockSize) noexcept;
+	void captureBlockStart(const juce::MidiBuffer& midi, int numSamples, juce::AudioPlayHead* playHead, int qualityTier) noexcept;
+	void captureBlockEnd(double seconds, const juce::AudioBuffer<float>& output) noexcept;
+
+	//==============================================================================
+	struct Session
+	{
+		struct Block
+		{
+			int numSamples = 0;
+			juce::MidiBuffer midi;
+			std::optional<double> bpm;
+			std::optional<double> ppqPosition;
+			bool isPlaying = false;
+			// QualityGovernor::Tier del bloque; -1 en capturas de la version 1
+			int qualityTier = -1;
+			// Medidos al capturar; negativos si el bloque no llego a cerrarse
+			float seconds = -1.0f;
+			float outputPeak = -1.0f;
+		};
+
+		// Un setter con sus argumentos o, si setter esta vacio, un estado completo
+		struct Change
+		{
+			juce::int64 beforeBlock = 0;
+			juce::String setter;
+			juce::Array<juce::var> arguments;
+			juce::MemoryBlock state;
+		};
+
+		struct Prepare
+		{
+			juce::int64 beforeBlock = 0;
+			double sampleRate = 44100.0;
+			int blockSize = 512;
+		};
+
+		double sampleRate = 44100.0;
+		int blockSize = 512;
+		int numChannels = 2;
+		// Habia voces sonando al empezar la captura
+		bool startedMidSession = false;
+		// Se perdieron bloques porque el escritor no daba abasto
+		bool incomplete = false;
+		juce::MemoryBlock initialState;
+		std::vector<Block> blocks;
+		std::vector<Change> changes;
+		std::vector<Prepare> prepares;
+	};
+
+	struct ReplayResult
+	{
+		int numBlocks = 0;
+		double renderSeconds = 0.0;
+		double capturedSeconds = 0.0;
+		// Bloques mas lentos que su duracion, al capturar y al reproducir
+		int capturedOverruns = 0;
+		int replayOverruns = 0;
+		int slowestBlock = -1;
+		double slowestBlockSeconds = 0.0;
+		// Primer bloque cuyo pico de salida no coincide con el capturado
+		int firstMismatchBlock = -1;
+		float maxPeakError = 0.0f;
+		juce::String message;
+	};
+
+	// Devuelve false y rellena error si el fichero no es una captura valida
+	static bool load(const juce::File& file, Session& session, juce::String& error);
+	// Si outputFile no esta vacio la salida se escribe ahi como WAV de 32 bits float
+	static ReplayResult replay(const Session& session, const juce::File& outputFile = {});
+	static juce::String formatReport(const ReplayResult& result);
+
+private:
+	void run() override;
+	bool push(const char* data, int size) noexcept;
+	void drain();
+	void addChange(Session::Change change);
+	void writeChange(const Session::Change& change);
+
+	SynthAudioProcessor& owner;
+	juce::File file;
+	std::unique_ptr<juce::FileOutputStream> stream;
+
+	juce::AbstractFifo fifo{ fifoBytes };
+	juce::HeapBlock<char> fifoData;
+	// Registro del bloque en curso, montado antes de entrar en la cola
+	juce::HeapBlock<char> scratch;
+
+	std::atomic<bool> active{ false };
+	std::atomic<bool> overflowed{ false };
+	std::atomic<juce::int64> blocksCaptured{ 0 };
+	bool blockOpen = false;
+
+	// Cambios del hilo de mensajes: la cola es solo del hilo de audio
+	juce::CriticalSection changeLock;
+	std::vector<Session::Change> pendingChanges;
+
+	JUCE_DECLARE_NON_COPYABLE(SessionCapture)
+};
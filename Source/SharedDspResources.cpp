@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    SharedDspResources.cpp
+    Created: 19 Oct 2026 1:12:47pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "SharedDspResources.h"
+
+SharedDspResources::SharedDspResources()
+{
+    const auto pi = juce::MathConstants<float>::pi;
+
+    // Las tablas de onda cubren x en [-pi, pi), igual que juce::dsp::Oscillator
+    auto fillWaveform = [pi](std::array<float, waveformTableSize + 1>& table, auto&& function) {
+        for (int i = 0; i < waveformTableSize; ++i)
+            table[(size_t)i] = function(juce::jmap((float)i, 0.0f, (float)waveformTableSize, -pi, pi));
+        table[waveformTableSize] = table[0];
+        };
+
+    fillWaveform(waveforms[0], [](float x) { return std::sin(x); });
+    fillWaveform(waveforms[1], [](float x) { return x < 0.0f ? -1.0f : 1.0f; });
+    fillWaveform(waveforms[2], [pi](float x) { return x / pi; });
+    fillWaveform(waveforms[3], [pi](float x) { return std::asin(std::sin(x)) * (2.0f / pi); });
+
+    // Basic: seno, triangulo, sierra y cuadrada
+    wavetables[0].build(4, [pi](int frame, int harmonic) {
+        const auto k = (float)harmonic;
+        const bool odd = (harmonic & 1) != 0;
+
+        switch (frame)
+        {
+            case 0:  return harmonic == 1 ? 1.0f : 0.0f;
+            case 1:  return odd ? (8.0f / (pi * pi)) * ((harmonic & 2) != 0 ? -1.0f : 1.0f) / (k * k) : 0.0f;
+            case 2:  return (2.0f / pi) * (odd ? 1.0f : -1.0f) / k;
+            default: return odd ? (4.0f / pi) / k : 0.0f;
+        }
+        });
+
+    // Pulse: ancho de pulso del 50% al 5%
+    wavetables[1].build(16, [pi](int frame, int harmonic) {
+        const auto width = 0.5f - 0.45f * (float)frame / 15.0f;
+        return (2.0f / (pi * (float)harmonic)) * std::sin(pi * (float)harmonic * width);
+        });
+
+    // Harmonics: una sierra que va ganando armonicos, de 1 a 256
+    wavetables[2].build(16, [](int frame, int harmonic) {
+        const auto numHarmonics = std::pow(2.0f, (float)frame * 8.0f / 15.0f);
+        return (float)harmonic <= numHarmonics + 0.5f ? 1.0f / (float)harmonic : 0.0f;
+        });
+
+    for (int i = 0; i <= panTableSize; ++i)
+        panTable[(size_t)i] = std::sin(juce::MathConstants<float>::halfPi * (float)i / (float)panTableSize);
+
+    for (int i = 0; i < windowSize; ++i)
+        hannWindow[(size_t)i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)(windowSize - 1));
+}
+
+const float* SharedDspResources::getWaveform(int type) const
+{
+    return waveforms[(size_t)juce::jlimit(0, numWaveforms - 1, type)].data();
+}
+
+const Wavetable& SharedDspResources::getWavetable(int index) const
+{
+    return wavetables[(size_t)juce::jlimit(0, numWavetables - 1, index)];
+}
+
+std::shared_ptr<const SharedDspResources::RateTables> SharedDspResources::getRateTables(double sampleRate)
+{
+    const juce::ScopedLock sl(rateTablesLock);
+
+    // Olvidar las tablas que ya no usa ninguna instancia
+    for (auto it = rateTables.begin(); it != rateTables.end();)
+        it = it->second.expired() && it->first != sampleRate ? rateTables.erase(it) : std::next(it);
+
+    if (auto existing = rateTables[sampleRate].lock())
+        return existing;
+
+    auto tables = std::make_shared<RateTables>();
+    tables->sampleRate = sampleRate;
+
+    for (int note = 0; note < 128; ++note)
+        tables->noteIncrements[(size_t)note] = (float)(juce::MidiMessage::getMidiNoteInHertz(note) * waveformTableSize / sampleRate);
+
+    rateTables[sampleRate] = tables;
+    return tables;
+}
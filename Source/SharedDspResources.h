@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+	SharedDspResources.h
+	Created: 19 Oct 2026 1:12:47pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Wavetable.h"
+
+// Tablas inmutables compartidas por todas las voces e instancias del plugin.
+// Se accede a traves de juce::SharedResourcePointer, asi que se construyen con
+// la primera instancia y se liberan al destruir la ultima.
+class SharedDspResources {
+
+public:
+	static constexpr int waveformTableSize = 128;
+	static constexpr int numWaveforms = 4;
+	static constexpr int numWavetables = 3;
+	static constexpr int windowSize = 2048;
+	static constexpr int panTableSize = 256;
+	// Ganancia de cada canal con la ley seno/coseno en el centro (-3 dB)
+	static constexpr float centrePanGain = 0.70710678f;
+	// La aplica el procesador una vez al bus estereo, no la tabla: una voz
+	// centrada suena igual que antes de tener panorama
+	static constexpr float panMakeupGain = 1.41421356f;
+
+	// Tablas que dependen de la frecuencia de muestreo
+	struct RateTables
+	{
+		double sampleRate = 0.0;
+		// Incremento de fase por muestra (en puntos de la tabla de onda) para cada nota MIDI en 12-TET
+		std::array<float, 128> noteIncrements{};
+	};
+
+	SharedDspResources();
+
+	// Tabla de waveformTableSize + 1 puntos para Sine, Square, Saw y Triangle
+	const float* getWaveform(int type) const;
+	// Tablas de frames para el oscilador con morphing: Basic, Pulse y Harmonics
+	const Wavetable& getWavetable(int index) const;
+	// Ganancias de panorama de potencia constante (seno y coseno), pan en [-1, 1]:
+	// left^2 + right^2 = 1 en cualquier posicion, centrePanGain en el centro.
+	void getPanGains(float pan, float& left, float& right) const noexcept
+	{
+		const auto position = (juce::jlimit(-1.0f, 1.0f, pan) + 1.0f) * 0.5f * (float)panTableSize;
+		const auto index = juce::jmin((int)position, panTableSize - 1);
+		const auto frac = position - (float)index;
+		right = panTable[(size_t)index] + frac * (panTable[(size_t)index + 1] - panTable[(size_t)index]);
+		left = panTable[(size_t)(panTableSize - index)] + frac * (panTable[(size_t)(panTableSize - index - 1)] - panTable[(size_t)(panTableSize - index)]);
+	}
+	// Ventana Hann de windowSize puntos para el analizador
+	const float* getHannWindow() const { return hannWindow.data(); }
+
+	// Solo desde prepareToPlay: puede reservar memoria y bloquea
+	std::shared_ptr<const RateTables> getRateTables(double sampleRate);
+
+private:
+	std::array<std::array<float, waveformTableSize + 1>, numWaveforms> waveforms{};
+	std::array<Wavetable, numWavetables> wavetables;
+	std::array<float, windowSize> hannWindow{};
+	// Cuarto de seno para las ganancias de panorama (leido al reves da el coseno)
+	std::array<float, panTableSize + 1> panTable{};
+
+	juce::CriticalSection rateTablesLock;
+	std::map<double, std::weak_ptr<const RateTables>> rateTables;
+
+	JUCE_DECLARE_NON_COPYABLE(SharedDspResources)
+};
@@ -0,0 +1,368 @@
+/*
+  ==============================================================================
+
+    StreamingSampler.cpp
+    Created: 19 Oct 2026 3:48:19pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "StreamingSampler.h"
+#include "SharedDspResources.h"
+
+//==============================================================================
+StreamingSamplerSound::Ptr StreamingSamplerSound::create(juce::AudioFormatManager& formatManager, const SampleZone& zone)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader;
+
+    // Los WAV se leen mapeados en memoria; el resto (FLAC) con un lector normal
+    if (zone.file.hasFileExtension("wav"))
+    {
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(wavFormat.createMemoryMappedReader(zone.file));
+
+        if (mappedReader != nullptr && mappedReader->mapEntireFile())
+            reader = std::move(mappedReader);
+    }
+
+    if (reader == nullptr)
+        reader.reset(formatManager.createReaderFor(zone.file));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return nullptr;
+
+    return new StreamingSamplerSound(std::move(reader), zone);
+}
+
+StreamingSamplerSound::StreamingSamplerSound(std::unique_ptr<juce::AudioFormatReader> r, const SampleZone& zone)
+    : reader(std::move(r)),
+      rootNote(zone.rootNote)
+{
+    keyZone = { zone.lowNote, zone.highNote, zone.lowVelocity, zone.highVelocity };
+    lengthInSamples = reader->lengthInSamples;
+    sourceSampleRate = reader->sampleRate;
+
+    const auto numPreload = (int)juce::jmin((juce::int64)preloadFrames, lengthInSamples);
+    preload.setSize(2, numPreload);
+    reader->read(&preload, 0, numPreload, 0, true, true);
+}
+
+//==============================================================================
+DiskStreamer::DiskStreamer(int numSlots)
+    : juce::Thread("Sampler disk streamer")
+{
+    for (int i = 0; i < numSlots; ++i)
+        slots.push_back(std::make_unique<Slot>());
+}
+
+DiskStreamer::~DiskStreamer()
+{
+    stopThread(2000);
+}
+
+void DiskStreamer::start()
+{
+    if (! isThreadRunning())
+        startThread(juce::Thread::Priority::high);
+}
+
+juce::uint32 DiskStreamer::startStream(int slotIndex, StreamingSamplerSound* sound, juce::int64 startFrame) noexcept
+{
+    auto& slot = *slots[(size_t)slotIndex];
+    // 0 se reserva para "ninguna" en stopSequence
+    slot.nextSequence = juce::jmax((juce::uint32)1, (slot.nextSequence + 1) & 0x7fffff);
+    const auto sequence = slot.nextSequence;
+
+    slot.pendingSound.store(sound, std::memory_order_release);
+    slot.pendingCommand.store(((juce::int64)sequence << sequenceShift) | (startFrame + 1), std::memory_order_release);
+    return sequence;
+}
+
+void DiskStreamer::stopStream(int slotIndex, juce::uint32 sequence) noexcept
+{
+    // El hilo de disco lo atiende despues de cualquier arranque pendiente, asi que
+    // una parada vieja nunca corta un stream posterior
+    slots[(size_t)slotIndex]->stopSequence.store(sequence, std::memory_order_release);
+}
+
+bool DiskStreamer::isUsingSound(const StreamingSamplerSound* sound) const noexcept
+{
+    for (const auto& slot : slots)
+    {
+        if (slot->sound.load(std::memory_order_acquire) == sound)
+            return true;
+
+        // pendingSound solo cuenta mientras la orden no se ha atendido
+        if (slot->pendingCommand.load(std::memory_order_acquire) != noCommand && slot->pendingSound.load(std::memory_order_acquire) == sound)
+            return true;
+    }
+
+    return false;
+}
+
+int DiskStreamer::read(int slotIndex, juce::uint32 sequence, float* left, float* right, int maxFrames) noexcept
+{
+    auto& slot = *slots[(size_t)slotIndex];
+
+    // Mientras el hilo de disco no haya atendido el comando el buffer es de otro stream
+    if (slot.readySequence.load(std::memory_order_acquire) != sequence)
+        return 0;
+
+    const auto scope = slot.fifo.read(maxFrames);
+
+    if (scope.blockSize1 > 0)
+    {
+        juce::FloatVectorOperations::copy(left, slot.ring.getReadPointer(0, scope.startIndex1), scope.blockSize1);
+        juce::FloatVectorOperations::copy(right, slot.ring.getReadPointer(1, scope.startIndex1), scope.blockSize1);
+    }
+
+    if (scope.blockSize2 > 0)
+    {
+        juce::FloatVectorOperations::copy(left + scope.blockSize1, slot.ring.getReadPointer(0, scope.startIndex2), scope.blockSize2);
+        juce::FloatVectorOperations::copy(right + scope.blockSize1, slot.ring.getReadPointer(1, scope.startIndex2), scope.blockSize2);
+    }
+
+    return scope.blockSize1 + scope.blockSize2;
+}
+
+void DiskStreamer::run()
+{
+    while (! threadShouldExit())
+    {
+        bool didWork = false;
+
+        for (auto& slot : slots)
+            didWork = serviceSlot(*slot) || didWork;
+
+        if (! didWork)
+            wait(2);
+    }
+}
+
+bool DiskStreamer::serviceSlot(Slot& slot)
+{
+    bool didWork = false;
+
+    if (auto command = slot.pendingCommand.load(std::memory_order_acquire); command != noCommand)
+    {
+        const auto sequence = (juce::uint32)(command >> sequenceShift);
+        const auto startFrame = (command & (((juce::int64)1 << sequenceShift) - 1)) - 1;
+
+        // El hilo de audio no lee este slot hasta que readySequence coincide
+        slot.fifo.reset();
+        slot.sound.store(slot.pendingSound.load(std::memory_order_acquire), std::memory_order_release);
+        slot.diskPosition = juce::jmax((juce::int64)0, startFrame);
+        slot.readySequence.store(sequence, std::memory_order_release);
+
+        // La orden se quita despues de copiar el sonido para que isUsingSound no
+        // vea un hueco; si ha llegado otra entre medias se atiende en la siguiente vuelta
+        slot.pendingCommand.compare_exchange_strong(command, noCommand, std::memory_order_acq_rel);
+        didWork = true;
+    }
+
+    if (auto stop = slot.stopSequence.load(std::memory_order_acquire); stop != 0)
+    {
+        // Una parada de un stream que ya se sustituyo se descarta; la de un
+        // arranque que aun no se ha atendido espera a la siguiente vuelta
+        const auto age = (slot.readySequence.load(std::memory_order_relaxed) - stop) & 0x7fffff;
+
+        if (age == 0)
+            slot.sound.store(nullptr, std::memory_order_release);
+
+        if (age < 0x400000)
+        {
+            slot.stopSequence.compare_exchange_strong(stop, 0, std::memory_order_acq_rel);
+            didWork = true;
+        }
+    }
+
+    auto* sound = slot.sound.load(std::memory_order_relaxed);
+
+    if (sound == nullptr)
+        return didWork;
+
+    const auto remaining = sound->getLengthInSamples() - slot.diskPosition;
+
+    if (remaining <= 0 || slot.fifo.getFreeSpace() < juce::jmin((juce::int64)chunkFrames, remaining))
+        return didWork;
+
+    int start1, size1, start2, size2;
+    slot.fifo.prepareToWrite((int)juce::jmin((juce::int64)chunkFrames, remaining), start1, size1, start2, size2);
+
+    auto& reader = sound->getReader();
+
+    if (size1 > 0)
+        reader.read(&slot.ring, start1, size1, slot.diskPosition, true, true);
+    if (size2 > 0)
+        reader.read(&slot.ring, start2, size2, slot.diskPosition + size1, true, true);
+
+    slot.fifo.finishedWrite(size1 + size2);
+    slot.diskPosition += size1 + size2;
+    return true;
+}
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice(DiskStreamer& s, int index)
+    : streamer(s), slotIndex(index)
+{
+}
+
+bool StreamingSamplerVoice::canPlaySound(juce::SynthesiserSound* sound) {
+    return dynamic_cast<StreamingSamplerSound*>(sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound* sound, int currentPitchWheelPosition)
+{
+    currentSound = dynamic_cast<StreamingSamplerSound*>(sound);
+    jassert(currentSound != nullptr);
+
+    pitchRatio = std::pow(2.0, (midiNoteNumber - currentSound->getRootNote()) / 12.0)
+               * currentSound->getSourceSampleRate() / getSampleRate();
+    sourcePosition = 0.0;
+    velocityGain = velocity;
+
+    if (quickFading)
+    {
+        quickFading = false;
+        adsr.setParameters(envelope);
+    }
+
+    // El ataque sale de la precarga mientras el hilo de disco llena el buffer
+    stagingStart = currentSound->getPreloadLength();
+    stagingCount = 0;
+    streamSequence = streamer.startStream(slotIndex, currentSound, currentSound->getPreloadLength());
+
+    adsr.noteOn();
+}
+
+void StreamingSamplerVoice::stopNote(float velocity, bool allowTailOff)
+{
+    adsr.noteOff();
+
+    if (! allowTailOff)
+        stopStreaming();
+}
+
+void StreamingSamplerVoice::setEnvelope(const juce::ADSR::Parameters& newParameters)
+{
+    envelope = newParameters;
+
+    if (! quickFading)
+        adsr.setParameters(envelope);
+}
+
+void StreamingSamplerVoice::startQuickFade() noexcept
+{
+    quickFading = true;
+
+    auto parameters = envelope;
+    parameters.release = quickFadeSeconds;
+    adsr.setParameters(parameters);
+    adsr.noteOff();
+}
+
+void StreamingSamplerVoice::controllerMoved(int controllerNumber, int newControllerValue) {}
+void StreamingSamplerVoice::pitchWheelMoved(int newPitchWheelValue) {}
+
+void StreamingSamplerVoice::prepareToPlay(double sampleRate)
+{
+    adsr.setSampleRate(sampleRate);
+}
+
+void StreamingSamplerVoice::stopStreaming()
+{
+    streamer.stopStream(slotIndex, streamSequence);
+    currentSound = nullptr;
+    clearCurrentNote();
+}
+
+bool StreamingSamplerVoice::fetchFrame(juce::int64 frame, float& left, float& right) noexcept
+{
+    const auto& preload = currentSound->getPreload();
+
+    if (frame < preload.getNumSamples())
+    {
+        left = preload.getSample(0, (int)frame);
+        right = preload.getSample(1, (int)frame);
+        return true;
+    }
+
+    // Los frames se piden en orden creciente: se conserva el ultimo de la
+    // ventana (para interpolar) y se leen mas del buffer circular
+    while (frame >= stagingStart + stagingCount)
+    {
+        if (stagingCount > 0)
+        {
+            stagingLeft[0] = stagingLeft[(size_t)stagingCount - 1];
+            stagingRight[0] = stagingRight[(size_t)stagingCount - 1];
+            stagingStart += stagingCount - 1;
+            stagingCount = 1;
+        }
+
+        const auto numRead = streamer.read(slotIndex, streamSequence,
+                                           stagingLeft.data() + stagingCount, stagingRight.data() + stagingCount,
+                                           stagingFrames - stagingCount);
+        if (numRead == 0)
+            return false;
+
+        stagingCount += numRead;
+    }
+
+    const auto index = (size_t)(frame - stagingStart);
+    left = stagingLeft[index];
+    right = stagingRight[index];
+    return true;
+}
+
+void StreamingSamplerVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    if (currentSound == nullptr)
+        return;
+
+    const auto length = currentSound->getLengthInSamples();
+    const int numChannels = outputBuffer.getNumChannels();
+    bool hadUnderrun = false;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto index = (juce::int64)sourcePosition;
+
+        if (index + 1 >= length || ! adsr.isActive())
+        {
+            stopStreaming();
+            break;
+        }
+
+        float left0, right0, left1, right1;
+
+        // Si el disco no llega a tiempo suena silencio, nunca se espera
+        if (! fetchFrame(index, left0, right0) || ! fetchFrame(index + 1, left1, right1))
+        {
+            left0 = right0 = left1 = right1 = 0.0f;
+            hadUnderrun = true;
+        }
+
+        const auto frac = (float)(sourcePosition - (double)index);
+        const auto envelope = adsr.getNextSample() * gainLevel * velocityGain;
+
+        const auto left = (left0 + frac * (left1 - left0)) * envelope;
+        const auto right = (right0 + frac * (right1 - right0)) * envelope;
+
+        if (numChannels == 1)
+        {
+            outputBuffer.addSample(0, startSample + i, 0.5f * (left + right));
+        }
+        else
+        {
+            // Sin panorama propio: cuenta como centrada, el bus le devuelve los 3 dB
+            outputBuffer.addSample(0, startSample + i, left * SharedDspResources::centrePanGain);
+            outputBuffer.addSample(1, startSample + i, right * SharedDspResources::centrePanGain);
+        }
+
+        sourcePosition += pitchRatio;
+    }
+
+    if (hadUnderrun)
+        streamer.reportUnderrun();
+}
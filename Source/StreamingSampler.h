@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+	StreamingSampler.h
+	Created: 19 Oct 2026 3:48:19pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "KeyZone.h"
+
+// Zona de un instrumento multimuestra: que fichero suena en que rango de notas
+// y velocidades
+struct SampleZone
+{
+	juce::File file;
+	int rootNote = 60;
+	int lowNote = 0;
+	int highNote = 127;
+	int lowVelocity = 0;
+	int highVelocity = 127;
+};
+
+// Sonido de una muestra. Solo el ataque se guarda en memoria, el resto lo lee
+// el hilo de disco desde el fichero (mapeado en memoria si es WAV).
+class StreamingSamplerSound : public ZonedSound {
+
+public:
+	using Ptr = juce::ReferenceCountedObjectPtr<StreamingSamplerSound>;
+	static constexpr int preloadFrames = 16384;
+
+	static Ptr create(juce::AudioFormatManager& formatManager, const SampleZone& zone);
+
+	bool appliesToChannel(int midiChannel) override {
+		return true;
+	}
+
+	const juce::AudioBuffer<float>& getPreload() const { return preload; }
+	int getPreloadLength() const { return preload.getNumSamples(); }
+	juce::int64 getLengthInSamples() const { return lengthInSamples; }
+	double getSourceSampleRate() const { return sourceSampleRate; }
+	int getRootNote() const { return rootNote; }
+
+	// Solo desde el hilo de disco
+	juce::AudioFormatReader& getReader() { return *reader; }
+
+private:
+	StreamingSamplerSound(std::unique_ptr<juce::AudioFormatReader> reader, const SampleZone& zone);
+
+	std::unique_ptr<juce::AudioFormatReader> reader;
+	juce::AudioBuffer<float> preload;
+	juce::int64 lengthInSamples = 0;
+	double sourceSampleRate = 44100.0;
+	int rootNote;
+
+};
+
+// Hilo que rellena un buffer circular por voz. El hilo de audio solo copia de
+// esos buffers y nunca toca el disco.
+class DiskStreamer : private juce::Thread {
+
+public:
+	static constexpr int ringFrames = 16384;
+	static constexpr int chunkFrames = 4096;
+
+	explicit DiskStreamer(int numSlots);
+	~DiskStreamer() override;
+
+	void start();
+
+	// Hilo de audio. startStream devuelve el numero de secuencia del stream.
+	juce::uint32 startStream(int slotIndex, StreamingSamplerSound* sound, juce::int64 startFrame) noexcept;
+	int read(int slotIndex, juce::uint32 sequence, float* left, float* right, int maxFrames) noexcept;
+	// Cualquier hilo: para el stream con esa secuencia si sigue siendo el del slot.
+	// No toca la secuencia del slot, que solo avanza en el hilo de audio.
+	void stopStream(int slotIndex, juce::uint32 sequence) noexcept;
+	// Hilo de mensajes: si algun slot lee aun de ese sonido o tiene una orden pendiente con el
+	bool isUsingSound(const StreamingSamplerSound* sound) const noexcept;
+	void reportUnderrun() noexcept { numUnderruns.fetch_add(1, std::memory_order_relaxed); }
+
+	int getNumUnderruns() const noexcept { return numUnderruns.load(); }
+
+private:
+	static constexpr juce::int64 noCommand = -1;
+	static constexpr int sequenceShift = 40;
+
+	struct Slot
+	{
+		juce::AbstractFifo fifo{ ringFrames };
+		juce::AudioBuffer<float> ring{ 2, ringFrames };
+
+		std::atomic<juce::int64> pendingCommand{ noCommand };
+		std::atomic<StreamingSamplerSound*> pendingSound{ nullptr };
+		std::atomic<juce::uint32> readySequence{ 0 };
+		// Secuencia que hay que parar; 0 = ninguna (las secuencias empiezan en 1)
+		std::atomic<juce::uint32> stopSequence{ 0 };
+
+		// Solo hilo de audio
+		juce::uint32 nextSequence = 0;
+
+		// Lo escribe solo el hilo de disco; atomico para que isUsingSound lo pueda mirar
+		std::atomic<StreamingSamplerSound*> sound{ nullptr };
+		juce::int64 diskPosition = 0;
+	};
+
+	void run() override;
+	bool serviceSlot(Slot& slot);
+
+	std::vector<std::unique_ptr<Slot>> slots;
+	std::atomic<int> numUnderruns{ 0 };
+
+	JUCE_DECLARE_NON_COPYABLE(DiskStreamer)
+};
+
+class StreamingSamplerVoice : public juce::SynthesiserVoice {
+
+public:
+	StreamingSamplerVoice(DiskStreamer& streamer, int slotIndex);
+
+	bool canPlaySound(juce::SynthesiserSound* sound) override;
+	void startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound* sound, int currentPitchWheelPosition) override;
+	void stopNote(float velocity, bool allowTailOff) override;
+	void controllerMoved(int controllerNumber, int newControllerValue) override;
+	void pitchWheelMoved(int newPitchWheelValue) override;
+	void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override;
+	void prepareToPlay(double sampleRate);
+	void setGain(float newGain) { gainLevel = newGain; }
+	void setEnvelope(const juce::ADSR::Parameters& newParameters);
+	// Fundido de unos milisegundos para liberar la voz (limite de polifonia)
+	void startQuickFade() noexcept;
+	bool isQuickFading() const noexcept { return quickFading; }
+
+	static constexpr float quickFadeSeconds = 0.005f;
+
+private:
+	bool fetchFrame(juce::int64 frame, float& left, float& right) noexcept;
+	void stopStreaming();
+
+	static constexpr int stagingFrames = 256;
+
+	DiskStreamer& streamer;
+	const int slotIndex;
+	juce::uint32 streamSequence = 0;
+
+	StreamingSamplerSound* currentSound = nullptr;
+	double sourcePosition = 0.0;
+	double pitchRatio = 1.0;
+
+	// Ventana de frames ya leidos del buffer circular
+	std::array<float, stagingFrames> stagingLeft{};
+	std::array<float, stagingFrames> stagingRight{};
+	juce::int64 stagingStart = 0;
+	int stagingCount = 0;
+
+	juce::ADSR adsr;
+	// Los de la parte; el fundido rapido los cambia hasta la siguiente nota
+	juce::ADSR::Parameters envelope;
+	bool quickFading = false;
+	float gainLevel = 0.5f;
+	float velocityGain = 1.0f;
+
+};
@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+    SynthEngine.cpp
+    Created: 19 Oct 2026 5:10:44pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "SynthEngine.h"
+#include "StreamingSampler.h"
+
+namespace
+{
+    bool isQuickFading(juce::SynthesiserVoice* voice) noexcept
+    {
+        if (auto* synthVoice = dynamic_cast<SynthVoice*>(voice))
+            return synthVoice->isQuickFading();
+        if (auto* samplerVoice = dynamic_cast<StreamingSamplerVoice*>(voice))
+            return samplerVoice->isQuickFading();
+        return false;
+    }
+}
+
+void SynthEngine::setSounds(juce::ReferenceCountedArray<juce::SynthesiserSound> newSounds)
+{
+    auto newMap = buildZoneMap(newSounds);
+
+    {
+        // Un solo intercambio: noteOn nunca ve sonidos de un conjunto con la tabla de otro
+        const juce::ScopedLock sl(lock);
+        sounds.swapWith(newSounds);
+        std::swap(zoneMap, newMap);
+    }
+
+    // Los sonidos y la tabla anteriores se liberan aqui, fuera del lock
+}
+
+std::unique_ptr<SynthEngine::ZoneMap> SynthEngine::buildZoneMap(const juce::ReferenceCountedArray<juce::SynthesiserSound>& mapSounds)
+{
+    auto newMap = std::make_unique<ZoneMap>();
+    newMap->sounds = mapSounds;
+
+    jassert(newMap->sounds.size() <= 256);
+
+    for (int i = 0; i < juce::jmin(256, newMap->sounds.size()); ++i)
+    {
+        auto* sound = newMap->sounds.getUnchecked(i);
+
+        // Los sonidos sin zona responden a todas las velocidades
+        KeyZone zone;
+
+        if (auto* zoned = dynamic_cast<ZonedSound*>(sound))
+            zone = zoned->getKeyZone();
+
+        for (int note = 0; note < 128; ++note)
+        {
+            if (! sound->appliesToNote(note))
+                continue;
+
+            for (int velocity = juce::jmax(0, zone.lowVelocity); velocity <= juce::jmin(127, zone.highVelocity); ++velocity)
+            {
+                auto& entry = newMap->entries[(size_t)(note * 128 + velocity)];
+
+                if (entry.numSounds < maxLayers)
+                    entry.soundIndices[(size_t)entry.numSounds++] = (juce::uint8)i;
+                else
+                    jassertfalse; // Demasiadas capas en la misma zona
+            }
+        }
+    }
+
+    return newMap;
+}
+
+void SynthEngine::noteOn(int midiChannel, int midiNoteNumber, float velocity)
+{
+    const juce::ScopedLock sl(lock);
+
+    const int mode = playMode.load(std::memory_order_relaxed);
+    const bool monophonic = mode == Mono || mode == Legato;
+    auto& notes = getChannelNotes(midiChannel);
+    const int previousHeldNote = notes.numHeldNotes > 0 ? notes.heldNotes[(size_t)notes.numHeldNotes - 1] : -1;
+
+    // Legato solo desliza entre notas solapadas; los demas modos desde la ultima nota del canal
+    const int glideFromNote = mode == Poly ? -1 : (mode == Legato ? previousHeldNote : notes.lastNote);
+
+    notes.remove(midiNoteNumber);
+    notes.heldNotes[(size_t)notes.numHeldNotes++] = midiNoteNumber;
+    notes.lastNote = midiNoteNumber;
+    notes.lastVelocity = velocity;
+
+    if (zoneMap == nullptr)
+    {
+        juce::Synthesiser::noteOn(midiChannel, midiNoteNumber, velocity);
+        return;
+    }
+
+    const auto& entry = zoneMap->get(midiNoteNumber, juce::jlimit(0, 127, juce::roundToInt(velocity * 127.0f)));
+    bool stoppedRinging = false;
+
+    for (int i = 0; i < entry.numSounds; ++i)
+    {
+        auto* sound = zoneMap->sounds.getUnchecked(entry.soundIndices[(size_t)i]);
+
+        if (! sound->appliesToChannel(midiChannel))
+            continue;
+
+        // Si la nota sigue sonando se para una vez, antes de lanzar todas las capas
+        if (! stoppedRinging)
+        {
+            for (auto* voice : voices)
+                if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel(midiChannel))
+                    stopVoice(voice, 1.0f, true);
+
+            if (! monophonic)
+                releaseOldestVoices(maxPolyphony.load(std::memory_order_relaxed) - 1);
+
+            stoppedRinging = true;
+        }
+
+        // En mono cada sonido reutiliza la voz que ya lo esta tocando
+        auto* voice = monophonic ? findMonoVoice(sound, midiChannel) : nullptr;
+        const bool legato = mode == Legato && previousHeldNote >= 0 && voice != nullptr;
+
+        if (voice == nullptr)
+        {
+            voice = findFreeVoice(sound, midiChannel, midiNoteNumber, isNoteStealingEnabled());
+
+            // Una voz libre que sigue sonando es una voz robada
+            if (voice != nullptr && voice->isVoiceActive())
+                traceVoice(TraceRecorder::VoiceSteal, voice, voice->getCurrentlyPlayingNote());
+        }
+
+        startNoteWithGlide(voice, sound, midiChannel, midiNoteNumber, velocity, glideFromNote, legato);
+    }
+}
+
+void SynthEngine::noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff)
+{
+    const juce::ScopedLock sl(lock);
+
+    auto& notes = getChannelNotes(midiChannel);
+    const bool wasSounding = notes.numHeldNotes > 0 && notes.heldNotes[(size_t)notes.numHeldNotes - 1] == midiNoteNumber;
+    notes.remove(midiNoteNumber);
+
+    const int mode = playMode.load(std::memory_order_relaxed);
+
+    if ((mode == Mono || mode == Legato) && wasSounding && notes.numHeldNotes > 0)
+    {
+        // Volver a la tecla que sigue pulsada en el mismo canal
+        const int returnNote = notes.heldNotes[(size_t)notes.numHeldNotes - 1];
+
+        for (auto* voice : voices)
+            if (voice->isVoiceActive() && voice->isKeyDown() && voice->getCurrentlyPlayingNote() == midiNoteNumber
+                && voice->isPlayingChannel(midiChannel))
+                startNoteWithGlide(voice, voice->getCurrentlyPlayingSound().get(), midiChannel, returnNote,
+                                   notes.lastVelocity, midiNoteNumber, mode == Legato);
+
+        notes.lastNote = returnNote;
+        return;
+    }
+
+    if (trace != nullptr)
+        for (auto* voice : voices)
+            if (voice->isKeyDown() && voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel(midiChannel))
+                traceVoice(TraceRecorder::VoiceRelease, voice, midiNoteNumber);
+
+    juce::Synthesiser::noteOff(midiChannel, midiNoteNumber, velocity, allowTailOff);
+}
+
+void SynthEngine::allNotesOff(int midiChannel, bool allowTailOff)
+{
+    const juce::ScopedLock sl(lock);
+
+    // Canal 0 (o menor) es todos los canales, como en juce::Synthesiser
+    if (midiChannel <= 0)
+        for (auto& notes : channelNotes)
+            notes.numHeldNotes = 0;
+    else
+        getChannelNotes(midiChannel).numHeldNotes = 0;
+
+    juce::Synthesiser::allNotesOff(midiChannel, allowTailOff);
+}
+
+void SynthEngine::startNoteWithGlide(juce::SynthesiserVoice* voice, juce::SynthesiserSound* sound, int midiChannel,
+                                     int midiNoteNumber, float velocity, int glideFromNote, bool legato)
+{
+    if (voice == nullptr)
+        return;
+
+    // Solo las voces de oscilador tienen portamento
+    if (auto* synthVoice = dynamic_cast<SynthVoice*>(voice))
+        synthVoice->setNextTransition(glideFromNote, legato,
+                                      glideTime.load(std::memory_order_relaxed),
+                                      glideConstantRate.load(std::memory_order_relaxed));
+
+    traceVoice(TraceRecorder::VoiceStart, voice, midiNoteNumber);
+    startVoice(voice, sound, midiChannel, midiNoteNumber, velocity);
+}
+
+juce::SynthesiserVoice* SynthEngine::findMonoVoice(juce::SynthesiserSound* sound, int midiChannel) const
+{
+    for (auto* voice : voices)
+        if (voice->isVoiceActive() && voice->getCurrentlyPlayingSound().get() == sound && voice->isPlayingChannel(midiChannel))
+            return voice;
+
+    return nullptr;
+}
+
+void SynthEngine::enforcePolyphony()
+{
+    const juce::ScopedLock sl(lock);
+    releaseOldestVoices(maxPolyphony.load(std::memory_order_relaxed));
+}
+
+void SynthEngine::startQuickFade(juce::SynthesiserVoice* voice)
+{
+    traceVoice(TraceRecorder::VoiceRelease, voice, voice->getCurrentlyPlayingNote());
+
+    if (auto* synthVoice = dynamic_cast<SynthVoice*>(voice))
+        synthVoice->startQuickFade();
+    else if (auto* samplerVoice = dynamic_cast<StreamingSamplerVoice*>(voice))
+        samplerVoice->startQuickFade();
+    else
+        stopVoice(voice, 0.0f, false);
+}
+
+void SynthEngine::releaseOldestVoices(int maxVoices)
+{
+    // Cuentan todas las voces que suenan, tambien las colas en release. Primero
+    // se funden rapido las colas mas antiguas; si no basta se suelta la tecla
+    // mas antigua (con noteOff, para que la pila de teclas siga al dia) y su
+    // cola se funde en la vuelta siguiente. Cada vuelta quita una voz o una
+    // tecla, asi que termina.
+    for (int attempt = 0; attempt < 2 * voices.size(); ++attempt)
+    {
+        juce::SynthesiserVoice* oldestTail = nullptr;
+        juce::SynthesiserVoice* oldestHeld = nullptr;
+        int numSounding = 0;
+
+        for (auto* voice : voices)
+        {
+            if (! voice->isVoiceActive() || isQuickFading(voice))
+                continue;
+
+            ++numSounding;
+            auto*& oldest = voice->isKeyDown() ? oldestHeld : oldestTail;
+
+            if (oldest == nullptr || voice->wasStartedBefore(*oldest))
+                oldest = voice;
+        }
+
+        if (numSounding <= maxVoices)
+            return;
+
+        if (oldestTail != nullptr)
+        {
+            startQuickFade(oldestTail);
+            continue;
+        }
+
+        if (oldestHeld == nullptr)
+            return;
+
+        const int note = oldestHeld->getCurrentlyPlayingNote();
+
+        for (int channel = 1; channel <= 16; ++channel)
+        {
+            if (oldestHeld->isPlayingChannel(channel))
+            {
+                noteOff(channel, note, 0.0f, true);
+                break;
+            }
+        }
+
+        // En mono la voz vuelve a otra tecla pulsada y sigue sonando
+        if (oldestHeld->isKeyDown())
+            return;
+    }
+}
+
+void SynthEngine::ChannelNotes::remove(int midiNoteNumber) noexcept
+{
+    for (int i = 0; i < numHeldNotes; ++i)
+    {
+        if (heldNotes[(size_t)i] == midiNoteNumber)
+        {
+            std::copy(heldNotes.begin() + i + 1, heldNotes.begin() + numHeldNotes, heldNotes.begin() + i);
+            --numHeldNotes;
+            return;
+        }
+    }
+}
+
+void SynthEngine::traceVoice(TraceRecorder::EventType type, juce::SynthesiserVoice* voice, int note) const noexcept
+{
+    if (trace != nullptr)
+        trace->record(type, voices.indexOf(voice), note);
+}
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+	SynthEngine.h
+	Created: 19 Oct 2026 5:10:44pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "KeyZone.h"
+#include "SynthVoice.h"
+#include "TraceRecorder.h"
+
+// juce::Synthesiser que resuelve cada note-on con una tabla nota x velocidad
+// en lugar de recorrer todos los sonidos. La tabla se reconstruye en el hilo
+// de mensajes cada vez que cambian los sonidos.
+// Tambien lleva los modos mono, legato y poly con portamento, con las teclas
+// pulsadas de cada canal MIDI por separado (en multitimbral, una parte por canal).
+class SynthEngine : public juce::Synthesiser {
+
+public:
+	// Sonidos que pueden sonar a la vez para una misma nota y velocidad
+	static constexpr int maxLayers = 16;
+
+	enum PlayMode {
+		Poly = 0,
+		PolyGlide,
+		Mono,
+		Legato
+	};
+
+	// Sustituye todos los sonidos y su tabla de zonas de una vez: el hilo de
+	// audio ve o los anteriores con su tabla o los nuevos con la suya.
+	// Nunca desde el hilo de audio.
+	void setSounds(juce::ReferenceCountedArray<juce::SynthesiserSound> newSounds);
+
+	// Mono reinicia la envolvente en cada nota; Legato solo si no habia teclas pulsadas
+	void setPlayMode(int newMode) { playMode = juce::jlimit((int)Poly, (int)Legato, newMode); }
+	int getPlayMode() const { return playMode.load(); }
+	// Portamento en segundos; con velocidad constante son segundos por octava
+	void setGlideTime(float seconds) { glideTime = juce::jmax(0.0f, seconds); }
+	float getGlideTime() const { return glideTime.load(); }
+	void setGlideConstantRate(bool shouldUseConstantRate) { glideConstantRate = shouldUseConstantRate; }
+	bool getGlideConstantRate() const { return glideConstantRate.load(); }
+
+	// Voces sonando a la vez, contando las colas en release; las que sobran se
+	// funden rapido, primero las colas mas antiguas y luego las teclas mas antiguas
+	void setMaxPolyphony(int voices) { maxPolyphony = juce::jmax(1, voices); }
+	int getMaxPolyphony() const { return maxPolyphony.load(); }
+	// Hilo de audio: aplicar un limite recien bajado a las notas que ya suenan
+	void enforcePolyphony();
+
+	// Registro de arranques, robos y releases de voces; nullptr para no registrar
+	void setTraceRecorder(TraceRecorder* recorder) { trace = recorder; }
+
+	void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
+	void noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override;
+	void allNotesOff(int midiChannel, bool allowTailOff) override;
+
+private:
+	void startNoteWithGlide(juce::SynthesiserVoice* voice, juce::SynthesiserSound* sound, int midiChannel,
+	                        int midiNoteNumber, float velocity, int glideFromNote, bool legato);
+	juce::SynthesiserVoice* findMonoVoice(juce::SynthesiserSound* sound, int midiChannel) const;
+	void releaseOldestVoices(int maxVoices);
+	void startQuickFade(juce::SynthesiserVoice* voice);
+	void traceVoice(TraceRecorder::EventType type, juce::SynthesiserVoice* voice, int note) const noexcept;
+
+	struct ZoneMap;
+	static std::unique_ptr<ZoneMap> buildZoneMap(const juce::ReferenceCountedArray<juce::SynthesiserSound>& mapSounds);
+
+	struct ZoneMap
+	{
+		struct Entry
+		{
+			std::array<juce::uint8, maxLayers> soundIndices{};
+			int numSounds = 0;
+		};
+
+		const Entry& get(int note, int velocity) const noexcept { return entries[(size_t)(note * 128 + velocity)]; }
+
+		// Mantiene vivos los sonidos mientras la tabla los referencia
+		juce::ReferenceCountedArray<juce::SynthesiserSound> sounds;
+		std::array<Entry, 128 * 128> entries;
+	};
+
+	std::unique_ptr<ZoneMap> zoneMap;
+
+	std::atomic<int> playMode{ Poly };
+	std::atomic<float> glideTime{ 0.1f };
+	std::atomic<bool> glideConstantRate{ false };
+	std::atomic<int> maxPolyphony{ std::numeric_limits<int>::max() };
+
+	// Teclas pulsadas de un canal en orden de pulsacion (la ultima es la que suena en mono)
+	struct ChannelNotes
+	{
+		void remove(int midiNoteNumber) noexcept;
+
+		std::array<int, 128> heldNotes{};
+		int numHeldNotes = 0;
+		int lastNote = -1;
+		float lastVelocity = 0.0f;
+	};
+
+	ChannelNotes& getChannelNotes(int midiChannel) noexcept { return channelNotes[(size_t)juce::jlimit(1, 16, midiChannel) - 1]; }
+
+	std::array<ChannelNotes, 16> channelNotes;
+
+	TraceRecorder* trace = nullptr;
+
+};
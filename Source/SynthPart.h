@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+	SynthPart.h
+	Created: 19 Oct 2026 4:27:12pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "KeyZone.h"
+
+// Parametros de una parte del modo multitimbral. Los escribe el hilo de mensajes
+// y los leen las voces; cada cambio sube la version para que las voces que
+// estan sonando vuelvan a leerlos en el siguiente bloque.
+struct SynthPart
+{
+	// Operador del motor FM (forma de onda Fm)
+	struct FmOperatorParameters
+	{
+		std::atomic<float> ratio{ 1.0f };
+		std::atomic<float> level{ 0.0f };
+		std::atomic<float> attack{ 0.01f };
+		std::atomic<float> decay{ 0.3f };
+		std::atomic<float> sustain{ 0.7f };
+		std::atomic<float> release{ 0.5f };
+	};
+
+	SynthPart()
+	{
+		// Por defecto: portador 1 modulado suavemente por el 2 a la octava
+		fmOperators[0].level = 1.0f;
+		fmOperators[1].ratio = 2.0f;
+		fmOperators[1].level = 0.3f;
+	}
+
+	std::atomic<int> waveform{ 0 };
+	// El mismo 0.5 que ya tenia el slider de volumen. Antes las voces empezaban
+	// en 0.01 y solo pasaban a 0.5 al abrir el editor o cargar un estado, asi
+	// que sin editor el plugin sonaba unos 34 dB mas bajo
+	std::atomic<float> volume{ 0.5f };
+	std::atomic<float> attack{ 0.1f };
+	std::atomic<float> decay{ 0.1f };
+	std::atomic<float> sustain{ 1.0f };
+	std::atomic<float> release{ 0.4f };
+	std::atomic<float> reverbSend{ 1.0f };
+	// Tabla de frames (forma de onda Morph), posicion 0..1 y cuanto la mueve la envolvente
+	std::atomic<int> wavetable{ 0 };
+	std::atomic<float> wavetablePosition{ 0.0f };
+	std::atomic<float> wavetableScan{ 0.0f };
+	// Panorama de la voz: fijo, segun la nota (respecto al Do central) y aleatorio por nota
+	std::atomic<float> pan{ 0.0f };
+	std::atomic<float> panKeyTracking{ 0.0f };
+	std::atomic<float> panSpread{ 0.0f };
+	// Deriva analogica de afinacion por voz, en cents
+	std::atomic<float> drift{ 0.0f };
+	std::atomic<int> fmAlgorithm{ 0 };
+	std::atomic<float> fmFeedback{ 0.0f };
+	std::array<FmOperatorParameters, 4> fmOperators;
+	std::atomic<juce::uint32> version{ 0 };
+
+	void changed() noexcept { version.fetch_add(1, std::memory_order_release); }
+
+	// Canal MIDI (0 = todos) y zona de teclado de la parte en modo multitimbral.
+	// Solo hilo de mensajes: se aplican al reconstruir los sonidos.
+	int midiChannel = 0;
+	KeyZone keyZone;
+};
@@ -11,15 +11,25 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "SynthPart.h"
+#include "KeyZone.h"
 
-class SynthSound : public juce::SynthesiserSound {
+class SynthSound : public ZonedSound {
 
 public:
-	bool appliesToNote(int midiNoteNumber) override {
-		return true;
+	// midiChannel 0 responde a todos los canales
+	SynthSound(SynthPart& partToUse, int channel = 0, const KeyZone& zone = {}) : part(partToUse), midiChannel(channel) {
+		keyZone = zone;
 	}
-	bool appliesToChannel(int midiChannel) override {
-		return true;
+
+	bool appliesToChannel(int channel) override {
+		return midiChannel == 0 || channel == midiChannel;
 	}
 
+	SynthPart& getPart() { return part; }
+
+private:
+	SynthPart& part;
+	const int midiChannel;
+
 };
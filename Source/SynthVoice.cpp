@@ -10,91 +10,342 @@
 
 #include "SynthVoice.h"
 
+SynthVoice::SynthVoice(const MicroTuning& t)
+    : tuning(t)
+{
+}
+
 bool SynthVoice::canPlaySound(juce::SynthesiserSound* sound) {
-    return dynamic_cast<juce::SynthesiserSound*>(sound) != nullptr;
+    return dynamic_cast<SynthSound*>(sound) != nullptr;
 }
 void SynthVoice::startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound* sound, int currentPitchWheelPosition)
 {
-    osc.setFrequency(juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber));
+    // La voz toma los parametros de la parte (canal MIDI) a la que pertenece el sonido
+    auto* synthSound = dynamic_cast<SynthSound*>(sound);
+    jassert(synthSound != nullptr);
+    part = &synthSound->getPart();
+    quickFading = false;
+    readPartParameters();
+
+    const bool legato = nextIsLegato && adsr.isActive();
+    const int glideFromNote = nextGlideFromNote;
+    nextGlideFromNote = -1;
+    nextIsLegato = false;
+
+    // Las teclas que la afinacion deja sin asignar no suenan
+    const auto targetIncrement = tuning.getNoteIncrement(midiNoteNumber);
+
+    if (targetIncrement <= 0.0f)
+    {
+        adsr.reset();
+        clearCurrentNote();
+        return;
+    }
+
+    // En legato se sigue desde el tono actual (aunque este a mitad de un portamento)
+    if (legato)
+    {
+        startGlide(phaseIncrement, targetIncrement);
+        return;
+    }
+
+    if (fmEnabled)
+        fm.noteOn();
+
+    lastMorphPosition = morphPosition;
+
+    // El panorama se fija al empezar la nota; la parte aleatoria sale del ruido de la voz
+    const auto pan = part->pan.load(std::memory_order_relaxed)
+                   + part->panKeyTracking.load(std::memory_order_relaxed) * (float)(midiNoteNumber - 60) / 64.0f
+                   + part->panSpread.load(std::memory_order_relaxed) * driftNoise.next();
+    sharedResources->getPanGains(pan, panLeft, panRight);
+
+    const auto fromIncrement = glideFromNote >= 0 ? tuning.getNoteIncrement(glideFromNote) : 0.0f;
+    startGlide(fromIncrement > 0.0f ? fromIncrement : targetIncrement, targetIncrement);
+
+    lastGainLevel = gainLevel;
     adsr.noteOn();
 
 }
 void SynthVoice::stopNote(float velocity, bool allowTailOff)
 {
+    // startVoice para la voz antes de un cambio legato: la envolvente sigue
+    if (nextIsLegato && ! allowTailOff)
+        return;
+
     adsr.noteOff();
+    fm.noteOff();
+
+    if (! allowTailOff)
+        clearCurrentNote();
+}
+void SynthVoice::startQuickFade() noexcept
+{
+    quickFading = true;
+
+    // noteOff calcula la pendiente desde el valor actual de la envolvente
+    auto parameters = adsr.getParameters();
+    parameters.release = quickFadeSeconds;
+    adsr.setParameters(parameters);
+    adsr.noteOff();
+    fm.noteOff();
 }
 void SynthVoice::controllerMoved(int controllerNumber, int newControllerValue) {}
 void SynthVoice::pitchWheelMoved(int newPitchWheelValue) {}
-void SynthVoice::prepareToPlay(double sampleRate, int samplesPerBlock, int outputCannels)
+size_t SynthVoice::getArenaBytesRequired(int samplesPerBlock)
+{
+    return DspArena::bytesForFloats(samplesPerBlock) * 2;
+}
+void SynthVoice::prepareToPlay(double sampleRate, int samplesPerBlock, DspArena& arena, EffectSendBus& bus)
 {
     adsr.setSampleRate(sampleRate);
+    fm.prepare(sampleRate);
 
-    juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.sampleRate = sampleRate;
-    spec.numChannels = outputCannels;
-
-    osc.prepare(spec);
-    gain.prepare(spec);
-
-    gain.setGainLinear(0.01f);
-    setOscillatorWaveform(0);
+    // La senal de la voz y su envolvente quedan seguidas en el arena
+    voiceBuffer = arena.allocateFloats(samplesPerBlock);
+    envelopeBuffer = arena.allocateFloats(samplesPerBlock);
+    maxBlockSize = samplesPerBlock;
+    sendBus = &bus;
 
-    reverb.prepare(spec);
+    // Sin nota no suena; startNote lo cambia por el volumen de la parte
+    gainLevel = lastGainLevel = 0.0f;
 
     isPrepared = true;
 }
-void SynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+void SynthVoice::setNextTransition(int glideFromNote, bool legato, float glideSeconds, bool constantRate)
 {
-    jassert(isPrepared);
-
-    juce::dsp::AudioBlock<float> audioBlock{ outputBuffer };
-    osc.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
-    gain.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
-    adsr.applyEnvelopeToBuffer(outputBuffer, startSample, numSamples);
-    if (reverbEnabled)
-        reverb.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+    nextGlideFromNote = glideSeconds > 0.0f ? glideFromNote : -1;
+    nextIsLegato = legato;
+    nextGlideSeconds = glideSeconds;
+    nextGlideConstantRate = constantRate;
 }
+void SynthVoice::startGlide(float fromIncrement, float toIncrement)
+{
+    glideTarget = toIncrement;
+    glideSamplesRemaining = 0;
+    phaseIncrement = toIncrement;
+
+    if (nextGlideSeconds <= 0.0f || fromIncrement == toIncrement)
+        return;
+
+    // Tiempo constante, o segundos por octava con velocidad constante
+    const auto octaves = std::abs(std::log2((double)toIncrement / (double)fromIncrement));
+    const auto seconds = nextGlideConstantRate ? nextGlideSeconds * octaves : (double)nextGlideSeconds;
 
-void SynthVoice::setGain(float newGain)
+    glideSamplesRemaining = juce::jmax(1, juce::roundToInt(seconds * getSampleRate()));
+    glideRatio = (float)std::pow((double)toIncrement / (double)fromIncrement, 1.0 / glideSamplesRemaining);
+    phaseIncrement = fromIncrement;
+}
+void SynthVoice::setNoiseSeed(juce::uint32 seed)
+{
+    noise.setSeed(seed);
+    driftNoise.setSeed(~seed);
+    driftValue = 0.0f;
+}
+float SynthVoice::advanceDrift(int numSamples) noexcept
 {
-    gain.setGainLinear(newGain);
+    // Proceso de Ornstein-Uhlenbeck de varianza 1 con medio segundo de memoria:
+    // la deriva no depende del tamano de bloque
+    const auto decay = std::exp(-(float)numSamples / (0.5f * (float)getSampleRate()));
+    driftValue = driftValue * decay + std::sqrt(1.0f - decay * decay) * driftNoise.next() * 1.7320508f;
+    return std::exp2(driftCents * driftValue / 1200.0f);
 }
+float SynthVoice::renderOscillator(float* dest, int numSamples, float increment, float ratio, float positionStep) noexcept
+{
+    if (fmEnabled)
+        return fm.render(dest, numSamples, increment / (float)tableSize, ratio) * (float)tableSize;
+
+    if (morphEnabled)
+        return renderMorph(dest, numSamples, increment, ratio, positionStep);
 
-void SynthVoice::setOscillatorWaveform(int type)
+    if (ratio != 1.0f)
+        return renderGlide(dest, numSamples, increment, ratio);
+
+    if (noiseEnabled)
+        noise.fill(dest, numSamples);
+    else
+        DspKernels::get().renderWavetable(dest, numSamples, waveTable, tableSize, phase, increment);
+
+    return increment;
+}
+float SynthVoice::renderGlide(float* dest, int numSamples, float increment, float ratio) noexcept
 {
-    switch (type)
+    // El ruido no tiene tono, pero el portamento tiene que seguir avanzando
+    if (noiseEnabled)
+    {
+        noise.fill(dest, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            increment *= ratio;
+
+        return increment;
+    }
+
+    const auto size = (float)tableSize;
+    auto p = phase;
+
+    for (int i = 0; i < numSamples; ++i)
     {
-    case Sine:
-        osc.initialise([](float x) { return std::sin(x); }, 128);
-        break;
-    case Square:
-        osc.initialise([](float x) { return x < 0.0f ? -1.0f : 1.0f; }, 128);
-        break;
-    case Saw:
-        osc.initialise([](float x) { return x / juce::MathConstants<float>::pi; }, 128);
-        break;
-    case Triangle:
-        osc.initialise([](float x) {
-            return std::asin(std::sin(x)) * (2.0f / juce::MathConstants<float>::pi);
-            }, 128);
-        break;
-    default:
-        break;
+        const auto index = (int)p;
+        const auto frac = p - (float)index;
+        dest[i] = waveTable[index] + frac * (waveTable[index + 1] - waveTable[index]);
+
+        p += increment;
+        if (p >= size)
+            p -= size;
+
+        increment *= ratio;
     }
+
+    phase = p;
+    return increment;
 }
-void SynthVoice::setReverbParams(float roomSize, float damping, float wetLevel, float dryLevel, float width, float freeze)
+float SynthVoice::renderMorph(float* dest, int numSamples, float increment, float ratio, float positionStep) noexcept
 {
-    reverbParams.roomSize = roomSize;
-    reverbParams.damping = damping;
-    reverbParams.wetLevel = wetLevel;
-    reverbParams.dryLevel = dryLevel;
-    reverbParams.width = width;
-    reverbParams.freezeMode = freeze;
-    reverb.setParameters(reverbParams);
+    auto& kernels = DspKernels::get();
+    const auto numFrames = morphTable->getNumFrames();
+    const auto frameScale = (float)(numFrames - 1);
+    auto cycles = phase / (float)tableSize;
+
+    // Con portamento el nivel mip se vuelve a elegir cada pocas muestras
+    const int chunkSize = ratio == 1.0f ? numSamples : 16;
+
+    for (int done = 0; done < numSamples;)
+    {
+        const int n = juce::jmin(chunkSize, numSamples - done);
+        const auto cyclesIncrement = increment / (float)tableSize;
+
+        // En el nivel elegido la fase avanza entre 1 y 2 puntos por muestra
+        const auto levelPosition = juce::jlimit(0.0f, (float)(Wavetable::numMipLevels - 1),
+                                                std::log2(juce::jmax(1.0f, cyclesIncrement * (float)Wavetable::baseFrameSize)));
+        const auto level = juce::jmin((int)levelPosition, Wavetable::numMipLevels - 2);
+
+        kernels.renderWavetableMorph(dest + done, n, morphTable->getLevel(level), Wavetable::getFrameSize(level), numFrames,
+                                     levelPosition - (float)level, cycles, cyclesIncrement,
+                                     lastMorphPosition * frameScale, positionStep * frameScale);
+
+        lastMorphPosition += positionStep * (float)n;
+
+        for (int i = 0; i < n && ratio != 1.0f; ++i)
+            increment *= ratio;
+
+        done += n;
+    }
+
+    phase = cycles * (float)tableSize;
+    return increment;
 }
+void SynthVoice::readPartParameters()
+{
+    partVersion = part->version.load(std::memory_order_acquire);
 
-void SynthVoice::setReverbEnabled(bool shouldEnable)
+    waveTable = sharedResources->getWaveform(part->waveform.load(std::memory_order_relaxed));
+    // Un cambio de la parte no debe alargar un fundido rapido ya empezado
+    if (! quickFading)
+        adsr.setParameters({ part->attack.load(std::memory_order_relaxed),
+                             part->decay.load(std::memory_order_relaxed),
+                             part->sustain.load(std::memory_order_relaxed),
+                             part->release.load(std::memory_order_relaxed) });
+    gainLevel = part->volume.load(std::memory_order_relaxed);
+    reverbSend = part->reverbSend.load(std::memory_order_relaxed);
+
+    fmEnabled = part->waveform.load(std::memory_order_relaxed) == Fm;
+    morphEnabled = part->waveform.load(std::memory_order_relaxed) == Morph;
+    morphTable = &sharedResources->getWavetable(part->wavetable.load(std::memory_order_relaxed));
+    morphPosition = part->wavetablePosition.load(std::memory_order_relaxed);
+    morphScan = part->wavetableScan.load(std::memory_order_relaxed);
+    noiseEnabled = part->waveform.load(std::memory_order_relaxed) >= NoiseWhite;
+    noise.setType(part->waveform.load(std::memory_order_relaxed) - NoiseWhite);
+    driftCents = part->drift.load(std::memory_order_relaxed);
+
+    if (fmEnabled)
+    {
+        FmOperators::Settings settings;
+        settings.algorithm = part->fmAlgorithm.load(std::memory_order_relaxed);
+        settings.feedback = part->fmFeedback.load(std::memory_order_relaxed);
+
+        for (size_t op = 0; op < FmOperators::numOperators; ++op)
+        {
+            const auto& source = part->fmOperators[op];
+            settings.ratios[op] = source.ratio.load(std::memory_order_relaxed);
+            settings.levels[op] = source.level.load(std::memory_order_relaxed);
+            settings.envelopes[op] = { source.attack.load(std::memory_order_relaxed),
+                                       source.decay.load(std::memory_order_relaxed),
+                                       source.sustain.load(std::memory_order_relaxed),
+                                       source.release.load(std::memory_order_relaxed) };
+        }
+
+        fm.setSettings(settings);
+    }
+}
+void SynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
 {
-    reverbEnabled = shouldEnable;
+    jassert(isPrepared);
+
+    if (! isVoiceActive() || part == nullptr)
+        return;
+
+    if (part->version.load(std::memory_order_acquire) != partVersion)
+        readPartParameters();
+
+    auto& kernels = DspKernels::get();
+
+    while (numSamples > 0)
+    {
+        const int blockSize = juce::jmin(numSamples, maxBlockSize);
+
+        for (int i = 0; i < blockSize; ++i)
+            envelopeBuffer[i] = adsr.getNextSample();
+
+        // La envolvente mueve la posicion de la tabla; se llega al valor del final del bloque
+        const auto morphTarget = juce::jlimit(0.0f, 1.0f, morphPosition + morphScan * envelopeBuffer[blockSize - 1]);
+        const auto morphStep = (morphTarget - lastMorphPosition) / (float)blockSize;
+
+        // La deriva desafina todo el bloque sin tocar el estado del portamento
+        const auto drift = driftCents > 0.0f ? advanceDrift(blockSize) : 1.0f;
+
+        int rendered = 0;
+
+        if (glideSamplesRemaining > 0)
+        {
+            rendered = juce::jmin(blockSize, glideSamplesRemaining);
+
+            const auto endIncrement = renderOscillator(voiceBuffer, rendered, phaseIncrement * drift, glideRatio, morphStep) / drift;
+
+            // Al acabar se fija el destino exacto para no arrastrar error de redondeo
+            glideSamplesRemaining -= rendered;
+            phaseIncrement = glideSamplesRemaining > 0 ? endIncrement : glideTarget;
+        }
+
+        if (rendered < blockSize)
+            renderOscillator(voiceBuffer + rendered, blockSize - rendered, phaseIncrement * drift, 1.0f, morphStep);
+
+        kernels.applyGainRamp(voiceBuffer, blockSize, lastGainLevel, gainLevel);
+        lastGainLevel = gainLevel;
+
+        kernels.multiply(voiceBuffer, envelopeBuffer, blockSize);
+
+        // Sumar la voz en la salida del sintetizador y en el bus de envio. Con dos o
+        // mas canales los pares van a la izquierda y los impares a la derecha.
+        const auto stereo = outputBuffer.getNumChannels() > 1;
+
+        for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
+            kernels.addWithGain(outputBuffer.getWritePointer(channel, startSample), voiceBuffer, blockSize,
+                                stereo ? ((channel & 1) == 0 ? panLeft : panRight) : 1.0f);
+
+        if (sendBus->isActive() && reverbSend > 0.0f)
+            for (int channel = 0; channel < sendBus->getNumChannels(); ++channel)
+                kernels.addWithGain(sendBus->getWritePointer(channel, startSample), voiceBuffer, blockSize,
+                                    reverbSend * (stereo ? ((channel & 1) == 0 ? panLeft : panRight) : 1.0f));
+
+        startSample += blockSize;
+        numSamples -= blockSize;
+
+        if (! adsr.isActive())
+        {
+            clearCurrentNote();
+            part = nullptr;
+            break;
+        }
+    }
 }
@@ -12,39 +12,110 @@
 
 #include <JuceHeader.h>
 #include "SynthSound.h"
+#include "DspKernels.h"
+#include "SharedDspResources.h"
+#include "DspArena.h"
+#include "EffectSendBus.h"
+#include "MicroTuning.h"
+#include "FmOperators.h"
+#include "NoiseGenerator.h"
 
 
 class SynthVoice : public juce::SynthesiserVoice {
 
 public:
+	explicit SynthVoice(const MicroTuning& tuning);
+
 	bool canPlaySound(juce::SynthesiserSound* sound) override;
 	void startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound* sound, int currentPitchWheelPosition) override;
 	void stopNote(float velocity, bool allowTailOff) override;
 	void controllerMoved(int controllerNumber, int newControllerValue) override;
 	void pitchWheelMoved(int newPitchWheelValue) override;
-	void prepareToPlay(double sampleRate, int samplesPerBlock, int outputChannels);
+	void prepareToPlay(double sampleRate, int samplesPerBlock, DspArena& arena, EffectSendBus& sendBus);
+	static size_t getArenaBytesRequired(int samplesPerBlock);
 	void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override;
-	void setGain(float newGain);
-	void setOscillatorWaveform(int type);
-	juce::ADSR& getADSR() { return adsr; }
-	void setReverbParams(float roomSize, float damping, float wetLevel, float dryLevel, float width, float freeze);
-	void setReverbEnabled(bool shouldEnable);
+	// Lo llama SynthEngine justo antes de startVoice. glideFromNote < 0 = sin portamento;
+	// legato = cambiar de nota sin reiniciar la envolvente.
+	void setNextTransition(int glideFromNote, bool legato, float glideSeconds, bool constantRate);
+	// Semilla del ruido y de la deriva de esta voz. Solo fuera del hilo de audio.
+	void setNoiseSeed(juce::uint32 seed);
+	// Fundido de unos milisegundos para liberar la voz (limite de polifonia)
+	void startQuickFade() noexcept;
+	bool isQuickFading() const noexcept { return quickFading; }
+
+	static constexpr float quickFadeSeconds = 0.005f;
 
 private:
+	void readPartParameters();
+	void startGlide(float fromIncrement, float toIncrement);
+	// Rellenan dest empezando con el incremento dado, multiplicado por ratio en cada
+	// muestra (portamento), y devuelven el incremento al acabar
+	float renderOscillator(float* dest, int numSamples, float increment, float ratio, float positionStep) noexcept;
+	float renderGlide(float* dest, int numSamples, float increment, float ratio) noexcept;
+	float renderMorph(float* dest, int numSamples, float increment, float ratio, float positionStep) noexcept;
+	float advanceDrift(int numSamples) noexcept;
+
 	juce::ADSR adsr;
-	juce::ADSR::Parameters adsrParams;
+	bool quickFading = false;
 	enum WaveformType {
 		Sine = 0,
 		Square,
 		Saw,
-		Triangle
+		Triangle,
+		Fm,
+		Morph,
+		NoiseWhite,
+		NoisePink,
+		NoiseBrown
 	};
-	juce::dsp::Oscillator<float> osc;
-	juce::dsp::Gain<float> gain;
+	// Las tablas de onda y de notas son compartidas por todas las voces
+	static constexpr int tableSize = SharedDspResources::waveformTableSize;
+	juce::SharedResourcePointer<SharedDspResources> sharedResources;
+	const MicroTuning& tuning;
+	const float* waveTable = sharedResources->getWaveform(Sine);
+	FmOperators fm;
+	bool fmEnabled = false;
+	// Oscilador con morphing: la posicion (en 0..1) va en rampa de un bloque al siguiente
+	const Wavetable* morphTable = nullptr;
+	bool morphEnabled = false;
+	float morphPosition = 0.0f;
+	float morphScan = 0.0f;
+	float lastMorphPosition = 0.0f;
+	// Ruido como oscilador, y ruido filtrado como deriva lenta de afinacion (en cents)
+	NoiseGenerator noise;
+	bool noiseEnabled = false;
+	NoiseGenerator driftNoise;
+	float driftCents = 0.0f;
+	float driftValue = 0.0f;
+	float phase = 0.0f;
+	float phaseIncrement = 0.0f;
+
+	// Portamento: el incremento se multiplica por glideRatio en cada muestra
+	int nextGlideFromNote = -1;
+	bool nextIsLegato = false;
+	float nextGlideSeconds = 0.0f;
+	bool nextGlideConstantRate = false;
+	float glideTarget = 0.0f;
+	float glideRatio = 1.0f;
+	int glideSamplesRemaining = 0;
+
+	// Parte que toca la nota actual y version de sus parametros ya leida
+	SynthPart* part = nullptr;
+	juce::uint32 partVersion = 0;
+
+	float gainLevel = 0.0f;
+	float lastGainLevel = 0.0f;
+	float reverbSend = 0.0f;
+	// Ganancias de panorama de la nota actual; se aplican solo al sumar en la salida
+	float panLeft = 1.0f;
+	float panRight = 1.0f;
 
-	juce::dsp::Reverb reverb;
-	juce::dsp::Reverb::Parameters reverbParams;
-	bool reverbEnabled = true;
+	// Buffers repartidos desde el arena del procesador. La voz es mono: se
+	// suma igual en todos los canales de la salida y del bus de envio.
+	float* voiceBuffer = nullptr;
+	float* envelopeBuffer = nullptr;
+	int maxBlockSize = 0;
+	EffectSendBus* sendBus = nullptr;
 
 
 	bool isPrepared{ false };
@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+    Created: 20 Oct 2026 12:12:40am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+
+TraceRecorder::TraceRecorder()
+    : juce::Thread("Trace dump"),
+      slots(std::make_unique<Slot[]>((size_t)capacity)),
+      dumpDirectory(juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("SynthTraces"))
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    stopThread(2000);
+}
+
+void TraceRecorder::record(EventType type, juce::int32 a, juce::int32 b, float value) noexcept
+{
+    // Reservar el hueco; mientras se escribe su secuencia no vale para ningun lector
+    const auto index = writeCount.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots[(size_t)(index & (capacity - 1))];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    juce::uint32 valueBits;
+    std::memcpy(&valueBits, &value, sizeof(valueBits));
+
+    slot.ticks.store(juce::Time::getHighResolutionTicks(), std::memory_order_relaxed);
+    slot.typeAndValue.store(((juce::uint64)type << 32) | valueBits, std::memory_order_relaxed);
+    slot.arguments.store(((juce::uint64)(juce::uint32)a << 32) | (juce::uint32)b, std::memory_order_relaxed);
+
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+int TraceRecorder::copyEvents(std::vector<Event>& destination) const
+{
+    const auto end = writeCount.load(std::memory_order_acquire);
+    const auto begin = end > (juce::uint64)capacity ? end - (juce::uint64)capacity : 0;
+
+    for (auto index = begin; index < end; ++index)
+    {
+        const auto& slot = slots[(size_t)(index & (capacity - 1))];
+
+        // Sin terminar o ya sobrescrito: se salta
+        if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+            continue;
+
+        const auto ticks = slot.ticks.load(std::memory_order_relaxed);
+        const auto typeAndValue = slot.typeAndValue.load(std::memory_order_relaxed);
+        const auto arguments = slot.arguments.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (slot.sequence.load(std::memory_order_relaxed) != index + 1)
+            continue;
+
+        Event event;
+        const auto valueBits = (juce::uint32)typeAndValue;
+        event.ticks = ticks;
+        event.type = (EventType)(typeAndValue >> 32);
+        event.a = (juce::int32)(juce::uint32)(arguments >> 32);
+        event.b = (juce::int32)(juce::uint32)arguments;
+        std::memcpy(&event.value, &valueBits, sizeof(valueBits));
+        destination.push_back(event);
+    }
+
+    return (int)destination.size();
+}
+
+void TraceRecorder::setDumpDirectory(const juce::File& directory)
+{
+    const juce::ScopedLock sl(fileLock);
+    dumpDirectory = directory;
+}
+
+juce::File TraceRecorder::getDumpDirectory() const
+{
+    const juce::ScopedLock sl(fileLock);
+    return dumpDirectory;
+}
+
+juce::File TraceRecorder::getLastDumpFile() const
+{
+    const juce::ScopedLock sl(fileLock);
+    return lastDumpFile;
+}
+
+bool TraceRecorder::dumpTo(const juce::File& file) const
+{
+    std::vector<Event> events;
+    events.reserve((size_t)capacity);
+    copyEvents(events);
+
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+    juce::FileOutputStream out(file);
+
+    if (! out.openedOk())
+        return false;
+
+    // Formato Trace Event de Chrome: tiempos en microsegundos desde el primer evento
+    const auto origin = events.empty() ? (juce::int64)0 : events.front().ticks;
+    bool first = true;
+    bool blockOpen = false;
+
+    // Los instantaneos van al hilo ("t") salvo los cortes, que se marcan en toda la traza ("g")
+    auto write = [&out, &first](const juce::String& name, char phase, const juce::String& timestamp, const juce::String& args, char scope = 't') {
+        out << (first ? "\n" : ",\n")
+            << "{\"name\":\"" << name << "\",\"ph\":\"" << juce::String::charToString(phase) << "\",\"pid\":1,\"tid\":1,\"ts\":" << timestamp
+            << (phase == 'i' ? ",\"s\":\"" + juce::String::charToString(scope) + "\"" : juce::String()) << ",\"args\":{" << args << "}}";
+        first = false;
+        };
+
+    out << "{\"traceEvents\":[";
+
+    for (const auto& event : events)
+    {
+        const auto timestamp = juce::String(juce::Time::highResolutionTicksToSeconds(event.ticks - origin) * 1.0e6, 3);
+
+        switch (event.type)
+        {
+            case BlockStart:
+                write("processBlock", 'B', timestamp, "\"samples\":" + juce::String(event.a));
+                blockOpen = true;
+                break;
+
+            case BlockEnd:
+                // Un final sin su principio (el anillo empezo a mitad de bloque) no se escribe
+                if (blockOpen)
+                    write("processBlock", 'E', timestamp, "\"load\":" + juce::String(event.value, 3));
+                blockOpen = false;
+                break;
+
+            case Overrun:
+                write("Overrun", 'i', timestamp, "\"load\":" + juce::String(event.value, 3), 'g');
+                break;
+
+            case Midi:
+            {
+                const juce::MidiMessage message(event.a, (event.b >> 8) & 0x7f, event.b & 0x7f);
+                write(message.getDescription(), 'i', timestamp, "\"position\":" + juce::String((int)event.value));
+                break;
+            }
+
+            case VoiceStart:
+                write("Voice start", 'i', timestamp, "\"voice\":" + juce::String(event.a) + ",\"note\":" + juce::String(event.b));
+                break;
+
+            case VoiceSteal:
+                write("Voice steal", 'i', timestamp, "\"voice\":" + juce::String(event.a) + ",\"note\":" + juce::String(event.b));
+                break;
+
+            case VoiceRelease:
+                write("Voice release", 'i', timestamp, "\"voice\":" + juce::String(event.a) + ",\"note\":" + juce::String(event.b));
+                break;
+
+            case ParameterChange:
+                write("Part parameters", 'i', timestamp, "\"part\":" + juce::String(event.a) + ",\"version\":" + juce::String(event.b));
+                break;
+
+            case QualityTier:
+                write("Quality tier", 'C', timestamp, "\"tier\":" + juce::String(event.a) + ",\"load\":" + juce::String(event.value, 3));
+                break;
+        }
+    }
+
+    out << "\n]}\n";
+    out.flush();
+    return out.getStatus().wasOk();
+}
+
+void TraceRecorder::run()
+{
+    // El hilo de audio solo levanta una bandera: aqui se mira unas cuantas veces por segundo
+    while (! threadShouldExit())
+    {
+        wait(200);
+
+        if (! dumpRequested.exchange(false, std::memory_order_acquire))
+            continue;
+
+        const auto now = juce::Time::getHighResolutionTicks();
+
+        if (lastAutoDumpTicks != 0 && juce::Time::highResolutionTicksToSeconds(now - lastAutoDumpTicks) < minSecondsBetweenAutoDumps)
+            continue;
+
+        lastAutoDumpTicks = now;
+        const auto file = getDumpDirectory().getChildFile("synth-trace-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".json");
+
+        if (dumpTo(file))
+        {
+            const juce::ScopedLock sl(fileLock);
+            lastDumpFile = file;
+        }
+    }
+}
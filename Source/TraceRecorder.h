@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+	TraceRecorder.h
+	Created: 20 Oct 2026 12:12:40am
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Registro de eventos del hilo de audio, siempre encendido, para encontrar
+// cortes raros en sesiones largas. Los eventos van a un anillo de tamano fijo:
+// cada escritor reserva su hueco con un fetch_add y lo marca con su numero de
+// secuencia al terminar, sin locks ni reservas de memoria. Un hilo aparte
+// vuelca el anillo a JSON de Chrome trace (chrome://tracing, Perfetto) cuando
+// se pide o cuando el hilo de audio detecta un bloque que no llego a tiempo.
+class TraceRecorder : private juce::Thread {
+
+public:
+	enum EventType : juce::uint16 {
+		BlockStart = 0,		// a = muestras
+		BlockEnd,			// a = muestras, value = carga del bloque
+		Overrun,			// value = carga del bloque
+		Midi,				// a = status, b = data1 << 8 | data2, value = posicion en el bloque
+		VoiceStart,			// a = voz, b = nota
+		VoiceSteal,			// a = voz, b = nota que se corta
+		VoiceRelease,		// a = voz, b = nota
+		ParameterChange,	// a = parte, b = version
+		QualityTier			// a = nivel, value = carga
+	};
+
+	struct Event
+	{
+		juce::int64 ticks = 0;
+		EventType type = BlockStart;
+		juce::int32 a = 0;
+		juce::int32 b = 0;
+		float value = 0.0f;
+	};
+
+	static constexpr int capacity = 1 << 16;
+	// Como mucho un volcado automatico cada tanto, por si los cortes se encadenan
+	static constexpr double minSecondsBetweenAutoDumps = 10.0;
+
+	TraceRecorder();
+	~TraceRecorder() override;
+
+	// Cualquier hilo, sin bloquear
+	void record(EventType type, juce::int32 a = 0, juce::int32 b = 0, float value = 0.0f) noexcept;
+	// Hilo de audio: pide un volcado al hilo de fondo; nunca escribe el fichero aqui
+	void requestDump() noexcept { dumpRequested.store(true, std::memory_order_release); }
+
+	// Hilo de mensajes
+	void setDumpDirectory(const juce::File& directory);
+	juce::File getDumpDirectory() const;
+	juce::File getLastDumpFile() const;
+	// Vuelca ya en el hilo que llama. Devuelve false si no se pudo escribir.
+	bool dumpTo(const juce::File& file) const;
+
+private:
+	// Los campos del evento van empaquetados en palabras atomicas que se leen y
+	// escriben relaxed: un lector puede copiarlas mientras otro hilo sobrescribe
+	// el hueco sin que sea una carrera de datos, y la secuencia dice si la copia vale
+	struct Slot
+	{
+		std::atomic<juce::uint64> sequence{ 0 };	// indice + 1 cuando el evento esta completo
+		std::atomic<juce::int64> ticks{ 0 };
+		std::atomic<juce::uint64> typeAndValue{ 0 };	// tipo << 32 | bits de value
+		std::atomic<juce::uint64> arguments{ 0 };		// a << 32 | b
+	};
+
+	void run() override;
+	int copyEvents(std::vector<Event>& destination) const;
+
+	std::unique_ptr<Slot[]> slots;
+	std::atomic<juce::uint64> writeCount{ 0 };
+	std::atomic<bool> dumpRequested{ false };
+
+	juce::CriticalSection fileLock;
+	juce::File dumpDirectory;
+	juce::File lastDumpFile;
+	juce::int64 lastAutoDumpTicks = 0;
+
+	JUCE_DECLARE_NON_COPYABLE(TraceRecorder)
+};
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    Wavetable.cpp
+    Created: 19 Oct 2026 8:02:51pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "Wavetable.h"
+
+void Wavetable::build(int frames, const HarmonicFunction& amplitude)
+{
+    jassert(frames >= 2);
+    numFrames = frames;
+
+    size_t totalSize = 0;
+
+    for (int level = 0; level < numMipLevels; ++level)
+    {
+        levelOffsets[(size_t)level] = totalSize;
+        totalSize += (size_t)numFrames * (size_t)(getFrameSize(level) + 1);
+    }
+
+    data.allocate(totalSize, true);
+
+    // Cada nivel se sintetiza con una FFT inversa de su tamano, solo con los armonicos que le caben
+    std::vector<float> spectrum((size_t)(2 * baseFrameSize));
+    std::vector<float> gains((size_t)numFrames, 1.0f);
+
+    for (int level = 0; level < numMipLevels; ++level)
+    {
+        const auto frameSize = getFrameSize(level);
+        juce::dsp::FFT fft(juce::roundToInt(std::log2(frameSize)));
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+
+            for (int harmonic = 1; harmonic <= getNumHarmonics(level); ++harmonic)
+                spectrum[(size_t)(2 * harmonic + 1)] = -amplitude(frame, harmonic);
+
+            fft.performRealOnlyInverseTransform(spectrum.data());
+
+            // El pico del nivel 0 normaliza el frame en todos los niveles
+            if (level == 0)
+            {
+                const auto range = juce::FloatVectorOperations::findMinAndMax(spectrum.data(), frameSize);
+                const auto peak = juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd()));
+                gains[(size_t)frame] = peak > 0.0f ? 1.0f / peak : 0.0f;
+            }
+
+            auto* dest = data.get() + levelOffsets[(size_t)level] + (size_t)frame * (size_t)(frameSize + 1);
+            juce::FloatVectorOperations::multiply(dest, spectrum.data(), gains[(size_t)frame], frameSize);
+            dest[frameSize] = dest[0];
+        }
+    }
+}
@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+	Wavetable.h
+	Created: 19 Oct 2026 8:02:51pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Tabla de ondas de varios frames con niveles mip limitados en banda. Todo va en
+// un solo bloque: primero los frames del nivel 0, seguidos de los del nivel 1,
+// y asi. Cada frame tiene un punto extra que repite el primero. Al recorrer la
+// posicion solo se leen los frames de un nivel, que estan contiguos.
+class Wavetable {
+
+public:
+	static constexpr int baseFrameSize = 1024;
+	static constexpr int numMipLevels = 7;
+
+	// Amplitud del armonico (1 = fundamental) de un frame, en fase seno
+	using HarmonicFunction = std::function<float(int frame, int harmonic)>;
+
+	// Solo fuera del hilo de audio. Necesita al menos 2 frames.
+	void build(int numFrames, const HarmonicFunction& amplitude);
+
+	int getNumFrames() const noexcept { return numFrames; }
+	// Primer frame del nivel; el nivel siguiente empieza justo despues del ultimo frame
+	const float* getLevel(int level) const noexcept { return data.get() + levelOffsets[(size_t)level]; }
+
+	static constexpr int getFrameSize(int level) noexcept { return baseFrameSize >> level; }
+	// Armonicos que guarda cada nivel: con incrementos de hasta 2 puntos por muestra no hay aliasing
+	static constexpr int getNumHarmonics(int level) noexcept { return getFrameSize(level) / 4; }
+
+private:
+	juce::HeapBlock<float> data;
+	std::array<size_t, numMipLevels> levelOffsets{};
+	int numFrames = 0;
+
+};
@@ -0,0 +1,388 @@
+/*
+  ==============================================================================
+
+    GoldenAudio.cpp
+    Created: 19 Oct 2026 10:58:31pm
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "GoldenAudio.h"
+#include "../../Source/DspKernels.h"
+
+namespace
+{
+    // Frase corta: acorde, nota suelta con otra velocidad y silencio para el release
+    juce::MidiBuffer makePhrase(double sampleRate)
+    {
+        auto at = [sampleRate](double seconds) { return juce::roundToInt(seconds * sampleRate); };
+
+        juce::MidiBuffer midi;
+        for (auto note : { 48, 60, 64, 67 })
+        {
+            midi.addEvent(juce::MidiMessage::noteOn(1, note, (juce::uint8)100), at(0.0));
+            midi.addEvent(juce::MidiMessage::noteOff(1, note), at(0.6));
+        }
+
+        midi.addEvent(juce::MidiMessage::noteOn(1, 72, (juce::uint8)40), at(0.7));
+        midi.addEvent(juce::MidiMessage::noteOff(1, 72), at(1.0));
+        return midi;
+    }
+
+    // Acorde en el canal 1 y una linea en el canal 2, para los estados multitimbrales
+    juce::MidiBuffer makeTwoPartPhrase(double sampleRate)
+    {
+        auto at = [sampleRate](double seconds) { return juce::roundToInt(seconds * sampleRate); };
+
+        auto midi = makePhrase(sampleRate);
+        for (auto [note, start] : { std::pair{ 76, 0.1 }, std::pair{ 79, 0.35 }, std::pair{ 74, 0.6 } })
+        {
+            midi.addEvent(juce::MidiMessage::noteOn(2, note, (juce::uint8)90), at(start));
+            midi.addEvent(juce::MidiMessage::noteOff(2, note), at(start + 0.3));
+        }
+
+        return midi;
+    }
+
+    // Estado tal como lo guarda getStateInformation, escrito en XML para poder
+    // revisarlo: dos partes en canales distintos (FM y tabla de ondas con
+    // panorama), eco ping-pong, reverb y limitador
+    const char* const twoPartStateXml = R"(
+<SynthState volume="0.5" waveform="4" attack="0.01" decay="0.2" sustain="0.7" release="0.4"
+            roomSize="0.6" damping="0.4" wetLevel="0.3" dryLevel="0.7" width="1" freeze="0"
+            reverbEnabled="1" limiterEnabled="1" limiterCeiling="-1" limiterRelease="0.1"
+            qualityGovernor="0" internalBlockSize="0" internalBlockBuffered="0"
+            multitimbral="1" playMode="0" glideTime="0.1" glideConstantRate="0" noiseSeed="1234">
+  <Effects order="0 1 2 3 4 5" enabled="36" delayDivision="2" delayFeedback="0.4" delayMix="0.3"
+           delayMode="1" delayLowCut="80" delayHighCut="6000" delayModRate="0.4" delayModDepth="1"/>
+  <Part index="0" volume="0.5" waveform="4" attack="0.01" decay="0.2" sustain="0.7" release="0.4"
+        reverbSend="0.2" pan="-0.4" fmAlgorithm="1" fmFeedback="0.3" channel="1">
+    <FmOperator index="0" ratio="1" level="1" attack="0.005" decay="0.3" sustain="0.8" release="0.4"/>
+    <FmOperator index="1" ratio="2" level="0.6" attack="0.005" decay="0.2" sustain="0.5" release="0.3"/>
+    <FmOperator index="2" ratio="3" level="0.4" attack="0.01" decay="0.4" sustain="0.3" release="0.3"/>
+    <FmOperator index="3" ratio="1" level="0.3" attack="0.02" decay="0.5" sustain="0.2" release="0.2"/>
+  </Part>
+  <Part index="1" volume="0.4" waveform="5" attack="0.05" decay="0.3" sustain="0.6" release="0.5"
+        reverbSend="0.4" wavetable="1" wavetablePosition="0.3" wavetableScan="0.5"
+        pan="0.5" panSpread="0.2" channel="2"/>
+</SynthState>)";
+
+    juce::MemoryBlock makeState(const char* xml)
+    {
+        juce::MemoryBlock state;
+        juce::MemoryOutputStream stream(state, false);
+        juce::ValueTree::fromXml(xml).writeToStream(stream);
+        return state;
+    }
+
+    // Estado con una escala Scala de 19 notas iguales: sin la carga sincrona fuera
+    // de tiempo real, los primeros bloques sonarian en 12-TET
+    juce::MemoryBlock makeScalaState()
+    {
+        juce::String scl;
+        scl << "! 19edo.scl\n19 notas iguales por octava\n 19\n!\n";
+
+        for (int degree = 1; degree <= 19; ++degree)
+            scl << " " << juce::String(1200.0 * degree / 19.0, 5) << "\n";
+
+        auto state = juce::ValueTree::fromXml(R"(<SynthState volume="0.5" waveform="2" attack="0.01" decay="0.2" sustain="0.7" release="0.3"
+                                                             reverbEnabled="0" qualityGovernor="0" noiseSeed="1234"/>)");
+        state.setProperty("scala", scl, nullptr);
+
+        juce::MemoryBlock data;
+        juce::MemoryOutputStream stream(data, false);
+        state.writeToStream(stream);
+        return data;
+    }
+
+    float toDecibels(double power)
+    {
+        return (float)(10.0 * std::log10(juce::jmax(1.0e-20, power)));
+    }
+}
+
+juce::Array<GoldenAudio::Scenario> GoldenAudio::getDefaultScenarios()
+{
+    juce::Array<Scenario> scenarios;
+    const double sampleRate = 48000.0;
+
+    const char* waveformNames[] = { "sine", "square", "saw", "triangle", "fm", "morph", "noise-white", "noise-pink", "noise-brown" };
+
+    for (int waveform = 0; waveform < (int)std::size(waveformNames); ++waveform)
+    {
+        Scenario scenario;
+        scenario.name = juce::String("waveform-") + waveformNames[waveform];
+        scenario.configure = [waveform](SynthAudioProcessor& processor) {
+            processor.setCurrentWaveform(waveform);
+            processor.setReverbEnabled(false);
+            };
+        scenario.midi = makePhrase(sampleRate);
+        scenario.numSamples = juce::roundToInt(1.5 * sampleRate);
+        scenario.sampleRate = sampleRate;
+        scenarios.add(scenario);
+    }
+
+    Scenario reverb;
+    reverb.name = "reverb-tail";
+    reverb.configure = [](SynthAudioProcessor& processor) {
+        processor.setCurrentWaveform(SynthVoice::Saw);
+        processor.setCurrentReverbSend(0.8f);
+        processor.setCurrentReverbParameters(0.9f, 0.3f, 0.5f, 0.5f, 1.0f, 0.0f);
+        processor.setReverbEnabled(true);
+        };
+    reverb.midi = makePhrase(sampleRate);
+    reverb.numSamples = juce::roundToInt(3.0 * sampleRate);
+    reverb.sampleRate = sampleRate;
+    scenarios.add(reverb);
+
+    Scenario chain;
+    chain.name = "effects-chain";
+    chain.configure = [](SynthAudioProcessor& processor) {
+        processor.setCurrentWaveform(SynthVoice::Square);
+        processor.setCurrentReverbSend(0.5f);
+
+        for (int stage = 0; stage < MasterEffectChain::numStages; ++stage)
+            processor.getEffects().setStageEnabled(stage, true);
+        };
+    chain.midi = makePhrase(sampleRate);
+    chain.numSamples = juce::roundToInt(3.0 * sampleRate);
+    chain.sampleRate = sampleRate;
+    chain.blockSize = 128;
+    scenarios.add(chain);
+
+    // Se restaura con setStateInformation, igual que al abrir un proyecto
+    Scenario saved;
+    saved.name = "saved-state-two-parts";
+    saved.state = makeState(twoPartStateXml);
+    saved.midi = makeTwoPartPhrase(sampleRate);
+    saved.numSamples = juce::roundToInt(2.5 * sampleRate);
+    saved.sampleRate = sampleRate;
+    scenarios.add(saved);
+
+    Scenario scala;
+    scala.name = "saved-state-scala";
+    scala.state = makeScalaState();
+    scala.midi = makePhrase(sampleRate);
+    scala.numSamples = juce::roundToInt(1.5 * sampleRate);
+    scala.sampleRate = sampleRate;
+    scenarios.add(scala);
+
+    return scenarios;
+}
+
+juce::AudioBuffer<float> GoldenAudio::render(const Scenario& scenario, double* renderSeconds)
+{
+    // Ni de la CPU: las variantes SIMD no dan exactamente lo mismo que la escalar
+    DspKernels::setOverride(DspKernelVariants::getScalar());
+    const juce::ScopeGuard restoreKernels{ [] { DspKernels::setOverride(nullptr); } };
+
+    SynthAudioProcessor processor;
+    processor.setNonRealtime(true);
+
+    if (scenario.state.getSize() > 0)
+        processor.setStateInformation(scenario.state.getData(), (int)scenario.state.getSize());
+
+    if (scenario.configure)
+        scenario.configure(processor);
+
+    // La referencia no puede depender de la carga de la maquina que la genera
+    processor.setQualityGovernorEnabled(false);
+
+    processor.setRateAndBufferSizeDetails(scenario.sampleRate, scenario.blockSize);
+    processor.prepareToPlay(scenario.sampleRate, scenario.blockSize);
+
+    const int numChannels = processor.getTotalNumOutputChannels();
+    juce::AudioBuffer<float> output(numChannels, scenario.numSamples);
+    juce::AudioBuffer<float> block(numChannels, scenario.blockSize);
+    juce::MidiBuffer blockMidi;
+
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    for (int position = 0; position < scenario.numSamples; position += scenario.blockSize)
+    {
+        const int num = juce::jmin(scenario.blockSize, scenario.numSamples - position);
+        block.setSize(numChannels, num, false, false, true);
+        block.clear();
+
+        blockMidi.clear();
+        blockMidi.addEvents(scenario.midi, position, num, -position);
+        processor.processBlock(block, blockMidi);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            output.copyFrom(channel, position, block, channel, 0, num);
+    }
+
+    if (renderSeconds != nullptr)
+        *renderSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+    processor.releaseResources();
+    return output;
+}
+
+std::array<double, GoldenAudio::numBands> GoldenAudio::getBandPowers(const juce::AudioBuffer<float>& buffer, double sampleRate)
+{
+    constexpr int fftSize = 1 << fftOrder;
+    juce::dsp::FFT fft(fftOrder);
+    juce::dsp::WindowingFunction<float> window(fftSize, juce::dsp::WindowingFunction<float>::hann);
+    std::vector<float> frame((size_t)fftSize * 2);
+    std::array<double, numBands> bands{};
+
+    // Limites de banda repartidos en escala logaritmica
+    const auto nyquist = sampleRate * 0.5;
+    auto bandOf = [nyquist](int bin) {
+        const auto frequency = nyquist * (double)bin / (double)(fftSize / 2);
+        if (frequency < 20.0)
+            return -1;
+        return juce::jmin(numBands - 1, (int)((double)numBands * std::log(frequency / 20.0) / std::log(nyquist / 20.0)));
+        };
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        for (int start = 0; start + fftSize <= buffer.getNumSamples(); start += fftSize / 2)
+        {
+            std::fill(frame.begin(), frame.end(), 0.0f);
+            std::copy_n(buffer.getReadPointer(channel, start), fftSize, frame.begin());
+            window.multiplyWithWindowingTable(frame.data(), (size_t)fftSize);
+            fft.performFrequencyOnlyForwardTransform(frame.data());
+
+            for (int bin = 1; bin < fftSize / 2; ++bin)
+                if (const auto band = bandOf(bin); band >= 0)
+                    bands[(size_t)band] += (double)frame[(size_t)bin] * (double)frame[(size_t)bin];
+        }
+    }
+
+    return bands;
+}
+
+GoldenAudio::Result GoldenAudio::compare(const juce::AudioBuffer<float>& rendered, const juce::AudioBuffer<float>& reference,
+                                         double sampleRate, const Tolerance& tolerance)
+{
+    Result result;
+
+    if (rendered.getNumChannels() != reference.getNumChannels() || rendered.getNumSamples() != reference.getNumSamples())
+    {
+        result.message = "Distinto formato: " + juce::String(rendered.getNumChannels()) + "x" + juce::String(rendered.getNumSamples())
+                       + " frente a " + juce::String(reference.getNumChannels()) + "x" + juce::String(reference.getNumSamples());
+        return result;
+    }
+
+    // Test nulo: lo que queda al restar la referencia
+    juce::AudioBuffer<float> difference(rendered);
+    double sumOfSquares = 0.0;
+    float peak = 0.0f;
+
+    for (int channel = 0; channel < difference.getNumChannels(); ++channel)
+    {
+        auto* data = difference.getWritePointer(channel);
+        juce::FloatVectorOperations::subtract(data, reference.getReadPointer(channel), difference.getNumSamples());
+
+        for (int i = 0; i < difference.getNumSamples(); ++i)
+            sumOfSquares += (double)data[i] * (double)data[i];
+
+        peak = juce::jmax(peak, difference.getMagnitude(channel, 0, difference.getNumSamples()));
+    }
+
+    const auto numValues = juce::jmax(1, difference.getNumChannels() * difference.getNumSamples());
+    result.nullRmsDecibels = toDecibels(sumOfSquares / (double)numValues);
+    result.nullPeakDecibels = toDecibels((double)peak * (double)peak);
+
+    // Diferencia espectral por bandas; las bandas casi vacias en las dos no cuentan
+    const auto renderedBands = getBandPowers(rendered, sampleRate);
+    const auto referenceBands = getBandPowers(reference, sampleRate);
+
+    for (size_t band = 0; band < (size_t)numBands; ++band)
+    {
+        const auto a = toDecibels(renderedBands[band]);
+        const auto b = toDecibels(referenceBands[band]);
+
+        if (juce::jmax(a, b) > -60.0f)
+            result.spectralDecibels = juce::jmax(result.spectralDecibels, std::abs(a - b));
+    }
+
+    result.passed = result.nullRmsDecibels <= tolerance.maxNullRmsDecibels
+                 && result.nullPeakDecibels <= tolerance.maxNullPeakDecibels
+                 && result.spectralDecibels <= tolerance.maxSpectralDecibels;
+
+    if (! result.passed)
+        result.message = "Fuera de tolerancia";
+
+    return result;
+}
+
+juce::Array<GoldenAudio::Result> GoldenAudio::run(const juce::Array<Scenario>& scenarios, const juce::File& referenceDirectory,
+                                                  const Tolerance& tolerance, bool updateReferences)
+{
+    juce::Array<Result> results;
+    juce::WavAudioFormat wav;
+
+    for (const auto& scenario : scenarios)
+    {
+        double renderSeconds = 0.0;
+        const auto rendered = render(scenario, &renderSeconds);
+        const auto file = referenceDirectory.getChildFile(scenario.name + ".wav");
+
+        Result result;
+
+        if (updateReferences)
+        {
+            // Referencias en float de 32 bits: el test nulo no puede depender del dither
+            referenceDirectory.createDirectory();
+            file.deleteFile();
+
+            auto stream = std::make_unique<juce::FileOutputStream>(file);
+            std::unique_ptr<juce::AudioFormatWriter> writer(stream->openedOk() ? wav.createWriterFor(stream.get(), scenario.sampleRate,
+                                                                                                     (unsigned int)rendered.getNumChannels(), 32, {}, 0)
+                                                                               : nullptr);
+            if (writer != nullptr)
+                stream.release();
+
+            result.passed = writer != nullptr && writer->writeFromAudioSampleBuffer(rendered, 0, rendered.getNumSamples());
+            result.message = result.passed ? "Referencia actualizada" : "No se pudo escribir " + file.getFullPathName();
+        }
+        else if (std::unique_ptr<juce::AudioFormatReader> reader(file.existsAsFile() ? wav.createReaderFor(new juce::FileInputStream(file), true) : nullptr);
+                 reader != nullptr)
+        {
+            juce::AudioBuffer<float> reference((int)reader->numChannels, (int)reader->lengthInSamples);
+            reader->read(&reference, 0, reference.getNumSamples(), 0, true, true);
+            result = compare(rendered, reference, scenario.sampleRate, tolerance);
+        }
+        else
+        {
+            result.referenceMissing = true;
+            result.message = "Falta " + file.getFullPathName();
+        }
+
+        result.name = scenario.name;
+        result.renderSeconds = renderSeconds;
+        result.realtimeFactor = renderSeconds > 0.0 ? ((double)scenario.numSamples / scenario.sampleRate) / renderSeconds : 0.0;
+        results.add(result);
+    }
+
+    return results;
+}
+
+juce::String GoldenAudio::formatReport(const juce::Array<Result>& results)
+{
+    juce::String report;
+    int numFailed = 0;
+
+    for (const auto& result : results)
+    {
+        report << (result.passed ? "OK    " : "FALLO ") << result.name.paddedRight(' ', 24)
+               << " nulo RMS " << juce::String(result.nullRmsDecibels, 1) << " dB"
+               << ", pico " << juce::String(result.nullPeakDecibels, 1) << " dB"
+               << ", espectro " << juce::String(result.spectralDecibels, 2) << " dB"
+               << ", " << juce::String(result.renderSeconds * 1000.0, 1) << " ms"
+               << " (x" << juce::String(result.realtimeFactor, 1) << " tiempo real)";
+
+        if (result.message.isNotEmpty())
+            report << "  " << result.message;
+
+        report << juce::newLine;
+        numFailed += result.passed ? 0 : 1;
+    }
+
+    report << juce::String(results.size() - numFailed) << "/" << juce::String(results.size()) << " escenarios correctos" << juce::newLine;
+    return report;
+}
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+	GoldenAudio.h
+	Created: 19 Oct 2026 10:58:31pm
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+// Renders de referencia para comprobar que una optimizacion no cambia el sonido.
+// Cada escenario es un estado guardado y una secuencia MIDI que se renderizan
+// offline a traves de SynthAudioProcessor. El resultado se compara con un WAV de
+// referencia (test nulo: RMS y pico de la diferencia, y diferencia espectral por
+// bandas) y se mide el tiempo de cada render, asi velocidad y exactitud se
+// revisan juntas. Los renders usan siempre los kernels escalares: la referencia
+// sale igual en cualquier CPU (la velocidad de cada variante la mide el
+// benchmark de kernels).
+class GoldenAudio {
+
+public:
+	struct Scenario
+	{
+		juce::String name;
+		// Estado de getStateInformation; vacio = estado por defecto
+		juce::MemoryBlock state;
+		// Ajustes que no van en el estado, despues de cargarlo
+		std::function<void(SynthAudioProcessor&)> configure;
+		// Eventos con la posicion en muestras desde el principio del render
+		juce::MidiBuffer midi;
+		int numSamples = 0;
+		double sampleRate = 48000.0;
+		int blockSize = 512;
+	};
+
+	struct Tolerance
+	{
+		float maxNullRmsDecibels = -90.0f;
+		float maxNullPeakDecibels = -70.0f;
+		// Mayor diferencia entre bandas espectrales, en dB
+		float maxSpectralDecibels = 0.5f;
+	};
+
+	struct Result
+	{
+		juce::String name;
+		bool passed = false;
+		bool referenceMissing = false;
+		float nullRmsDecibels = -200.0f;
+		float nullPeakDecibels = -200.0f;
+		float spectralDecibels = 0.0f;
+		double renderSeconds = 0.0;
+		// Segundos de audio por segundo de CPU
+		double realtimeFactor = 0.0;
+		juce::String message;
+	};
+
+	// Escenarios fijos: cada forma de onda, la reverb con su cola, la cadena completa
+	// y un estado guardado con dos partes
+	static juce::Array<Scenario> getDefaultScenarios();
+
+	static juce::AudioBuffer<float> render(const Scenario& scenario, double* renderSeconds = nullptr);
+	static Result compare(const juce::AudioBuffer<float>& rendered, const juce::AudioBuffer<float>& reference,
+	                      double sampleRate, const Tolerance& tolerance);
+
+	// Renderiza y compara con referenceDirectory/<nombre>.wav. Con updateReferences
+	// los WAV se reescriben con el render actual en vez de compararse.
+	static juce::Array<Result> run(const juce::Array<Scenario>& scenarios, const juce::File& referenceDirectory,
+	                               const Tolerance& tolerance, bool updateReferences);
+	static juce::String formatReport(const juce::Array<Result>& results);
+
+private:
+	static constexpr int fftOrder = 11;
+	static constexpr int numBands = 32;
+
+	// Potencia media por bandas logaritmicas de 20 Hz a Nyquist, todos los canales juntos
+	static std::array<double, numBands> getBandPowers(const juce::AudioBuffer<float>& buffer, double sampleRate);
+
+};
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    GoldenTests.cpp
+    Created: 20 Oct 2026 11:02:45am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "SynthTools.h"
+#include "GoldenAudio.h"
+
+namespace
+{
+    // Tools/GoldenReferences, buscando hacia arriba desde el ejecutable
+    // (Tools/Builds/<exportador>/...) o desde el directorio actual
+    juce::File findReferenceDirectory()
+    {
+        for (auto start : { juce::File::getSpecialLocation(juce::File::currentExecutableFile),
+                            juce::File::getCurrentWorkingDirectory() })
+        {
+            for (auto directory = start; directory != directory.getParentDirectory(); directory = directory.getParentDirectory())
+            {
+                if (directory.getChildFile("GoldenReferences").isDirectory())
+                    return directory.getChildFile("GoldenReferences");
+                if (directory.getChildFile("Tools/GoldenReferences").isDirectory())
+                    return directory.getChildFile("Tools/GoldenReferences");
+            }
+        }
+
+        return juce::File::getCurrentWorkingDirectory().getChildFile("GoldenReferences");
+    }
+}
+
+int SynthTools::runGoldenAudio(const juce::ArgumentList& args)
+{
+    const auto directory = args.containsOption("--dir") ? args.getFileForOption("--dir") : findReferenceDirectory();
+    const bool update = args.containsOption("--update");
+
+    std::cout << (update ? "Reescribiendo referencias en " : "Comparando con ") << directory.getFullPathName() << std::endl;
+
+    const auto results = GoldenAudio::run(GoldenAudio::getDefaultScenarios(), directory, {}, update);
+    std::cout << GoldenAudio::formatReport(results) << std::endl;
+
+    int numFailed = 0;
+    bool anyMissing = false;
+
+    for (const auto& result : results)
+    {
+        numFailed += result.passed ? 0 : 1;
+        anyMissing = anyMissing || result.referenceMissing;
+    }
+
+    if (anyMissing)
+        std::cout << "Faltan referencias: generarlas con 'SynthTools golden --update' y subirlas al repositorio" << std::endl;
+
+    return numFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,356 @@
+/*
+  ==============================================================================
+
+    KernelTests.cpp
+    Created: 20 Oct 2026 9:41:17am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "SynthTools.h"
+#include "../../Source/DspKernels.h"
+
+namespace
+{
+    constexpr int tableSize = 2048;
+    constexpr int frameSize = 1024;
+    constexpr int numFrames = 8;
+    constexpr int delayMask = (1 << 12) - 1;
+
+    // Longitudes que no son multiplo de 4, 8 ni 16, para pasar por las colas escalares
+    constexpr int testLengths[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 63, 100, 257, 1000 };
+
+    // Buffers con un float de mas delante: los destinos tambien se prueban sin alinear
+    struct Buffers
+    {
+        explicit Buffers(int size) : a((size_t)size + 1), b((size_t)size + 1) {}
+
+        float* first() noexcept { return a.data() + 1; }
+        float* second() noexcept { return b.data() + 1; }
+
+        std::vector<float> a, b;
+    };
+
+    void fillRandom(juce::Random& random, float* data, int numSamples, float range = 1.0f)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = (random.nextFloat() * 2.0f - 1.0f) * range;
+    }
+
+    float maxDifference(const float* a, const float* b, int numSamples)
+    {
+        float difference = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            difference = juce::jmax(difference, std::abs(a[i] - b[i]));
+        return difference;
+    }
+
+    // Un ciclo con unos pocos armonicos, como las tablas reales (limitadas en banda).
+    // Con ruido la pendiente entre puntos seria enorme y la pequena deriva de fase
+    // entre acumular muestra a muestra o por vectores pareceria un error.
+    void fillCycle(float* data, int size, int frame)
+    {
+        for (int i = 0; i <= size; ++i)
+        {
+            const auto x = juce::MathConstants<float>::twoPi * (float)(i % size) / (float)size;
+            data[i] = 0.6f * std::sin(x + 0.3f * (float)frame) + 0.3f * std::sin(3.0f * x) + 0.1f * std::cos(7.0f * x + (float)frame);
+        }
+    }
+
+    // Tablas de prueba con los puntos de guarda que esperan los kernels
+    struct TestData
+    {
+        TestData()
+        {
+            juce::Random random(1234);
+
+            table.resize((size_t)tableSize + 1);
+            fillCycle(table.data(), tableSize, 0);
+
+            // Nivel fino y, justo detras, el grueso de frameSize / 2
+            levels.resize((size_t)(numFrames * (frameSize + 1) + numFrames * (frameSize / 2 + 1)));
+            for (int frame = 0; frame < numFrames; ++frame)
+            {
+                fillCycle(levels.data() + frame * (frameSize + 1), frameSize, frame);
+                fillCycle(levels.data() + numFrames * (frameSize + 1) + frame * (frameSize / 2 + 1), frameSize / 2, frame);
+            }
+
+            frames.resize((size_t)(2 * (delayMask + 1 + 3)));
+            fillRandom(random, frames.data(), 2 * (delayMask + 1));
+            std::copy_n(frames.begin(), 6, frames.begin() + 2 * (delayMask + 1));
+        }
+
+        std::vector<float> table, levels, frames;
+    };
+
+    struct Check
+    {
+        const char* kernel;
+        float tolerance;
+        std::function<float(const DspKernels&, const DspKernels&, int length, juce::Random&)> run;
+    };
+
+    const TestData& getTestData()
+    {
+        static const TestData data;
+        return data;
+    }
+
+    // Cada comprobacion ejecuta el kernel de referencia y el probado con las mismas
+    // entradas y devuelve la mayor diferencia (la fase final cuenta como una salida mas)
+    std::vector<Check> makeChecks()
+    {
+        std::vector<Check> checks;
+
+        checks.push_back({ "renderWavetable", 1.0e-3f, [](const DspKernels& reference, const DspKernels& tested, int length, juce::Random& random) {
+            const auto& data = getTestData();
+            Buffers out(length);
+            const auto startPhase = random.nextFloat() * (float)tableSize;
+            const auto increment = 0.05f + random.nextFloat() * 60.0f;
+            auto phaseA = startPhase, phaseB = startPhase;
+
+            reference.renderWavetable(out.first(), length, data.table.data(), tableSize, phaseA, increment);
+            tested.renderWavetable(out.second(), length, data.table.data(), tableSize, phaseB, increment);
+
+            // Fase en unidades de indice: se compara en ciclos, como se oye
+            auto phaseDifference = std::abs(phaseA - phaseB);
+            phaseDifference = juce::jmin(phaseDifference, (float)tableSize - phaseDifference) / (float)tableSize;
+            return juce::jmax(maxDifference(out.first(), out.second(), length), phaseDifference);
+            } });
+
+        checks.push_back({ "renderWavetableMorph", 1.0e-3f, [](const DspKernels& reference, const DspKernels& tested, int length, juce::Random& random) {
+            const auto& data = getTestData();
+            Buffers out(length);
+            const auto startPhase = random.nextFloat() * 0.999f;
+            const auto increment = 0.0001f + random.nextFloat() * 0.05f;
+            const auto levelMix = random.nextFloat();
+            const auto position = random.nextFloat() * (float)(numFrames - 1) * 0.5f;
+            const auto positionIncrement = length > 0 ? random.nextFloat() * (float)(numFrames - 1) * 0.5f / (float)length : 0.0f;
+            auto phaseA = startPhase, phaseB = startPhase;
+
+            reference.renderWavetableMorph(out.first(), length, data.levels.data(), frameSize, numFrames, levelMix,
+                                           phaseA, increment, position, positionIncrement);
+            tested.renderWavetableMorph(out.second(), length, data.levels.data(), frameSize, numFrames, levelMix,
+                                        phaseB, increment, position, positionIncrement);
+
+            auto phaseDifference = std::abs(phaseA - phaseB);
+            phaseDifference = juce::jmin(phaseDifference, 1.0f - phaseDifference);
+            return juce::jmax(maxDifference(out.first(), out.second(), length), phaseDifference);
+            } });
+
+        checks.push_back({ "multiply", 1.0e-6f, [](const DspKernels& reference, const DspKernels& tested, int length, juce::Random& random) {
+            Buffers out(length), envelope(length);
+            fillRandom(random, out.first(), length);
+            std::copy_n(out.first(), length, out.second());
+            fillRandom(random, envelope.first(), length);
+
+            reference.multiply(out.first(), envelope.first(), length);
+            tested.multiply(out.second(), envelope.first(), length);
+            return maxDifference(out.first(), out.second(), length);
+            } });
+
+        checks.push_back({ "applyGainRamp", 1.0e-4f, [](const DspKernels& reference, const DspKernels& tested, int length, juce::Random& random) {
+            Buffers out(length);
+            fillRandom(random, out.first(), length);
+            std::copy_n(out.first(), length, out.second());
+            const auto startGain = random.nextFloat() * 2.0f;
+            const auto endGain = random.nextFloat() * 2.0f;
+
+            reference.applyGainRamp(out.first(), length, startGain, endGain);
+            tested.applyGainRamp(out.second(), length, startGain, endGain);
+            return maxDifference(out.first(), out.second(), length);
+            } });
+
+        checks.push_back({ "addWithGain", 1.0e-6f, [](const DspKernels& reference, const DspKernels& tested, int length, juce::Random& random) {
+            Buffers out(length), source(length);
+            fillRandom(random, out.first(), length);
+            std::copy_n(out.first(), length, out.second());
+            fillRandom(random, source.first(), length);
+            const auto gain = random.nextFloat() * 2.0f - 1.0f;
+
+            reference.addWithGain(out.first(), source.first(), length, gain);
+            tested.addWithGain(out.second(), source.first(), length, gain);
+            return maxDifference(out.first(), out.second(), length);
+            } });
+
+        checks.push_back({ "readDelayStereo", 1.0e-5f, [](const DspKernels& reference, const DspKernels& tested, int length, juce::Random& random) {
+            const auto& data = getTestData();
+            Buffers left(length), right(length), delays(length);
+            const auto writeIndex = random.nextInt(delayMask + 1);
+
+            // Retardos modulados, siempre >= numSamples + 2 como pide el kernel
+            const auto base = (float)(length + 2) + random.nextFloat() * 2000.0f;
+            for (int i = 0; i < length; ++i)
+                delays.first()[i] = base + 20.0f * std::sin(0.01f * (float)i) + 20.0f;
+
+            reference.readDelayStereo(left.first(), right.first(), data.frames.data(), delayMask, writeIndex, delays.first(), length);
+            tested.readDelayStereo(left.second(), right.second(), data.frames.data(), delayMask, writeIndex, delays.first(), length);
+            return juce::jmax(maxDifference(left.first(), left.second(), length), maxDifference(right.first(), right.second(), length));
+            } });
+
+        checks.push_back({ "renderFm", 1.0e-3f, [](const DspKernels& reference, const DspKernels& tested, int length, juce::Random& random) {
+            Buffers out(length);
+            DspKernels::FmState state;
+
+            // Cadena 4 > 3 > 2 > 1 con realimentacion y los 4 operadores sonando
+            for (size_t op = 0; op < 4; ++op)
+            {
+                state.phases[op] = random.nextFloat() * 0.999f;
+                state.ratios[op] = 0.5f + random.nextFloat() * 4.0f;
+                state.levels[op] = random.nextFloat();
+                state.carrierGains[op] = 0.25f;
+                state.envelopeValues[op] = random.nextFloat();
+                state.envelopeSteps[op] = length > 0 ? (random.nextFloat() - state.envelopeValues[op]) / (float)length : 0.0f;
+            }
+
+            state.modulators[3][2] = state.modulators[2][1] = state.modulators[1][0] = 1.0f;
+            state.modulators[3][3] = 0.1f * random.nextFloat();
+
+            auto stateB = state;
+            const auto startCycles = 0.0005f + random.nextFloat() * 0.02f;
+            const auto glideRatio = 1.0f + (random.nextFloat() - 0.5f) * 1.0e-4f;
+            auto cyclesA = startCycles, cyclesB = startCycles;
+
+            reference.renderFm(out.first(), length, state, cyclesA, glideRatio);
+            tested.renderFm(out.second(), length, stateB, cyclesB, glideRatio);
+
+            auto phaseDifference = 0.0f;
+            for (size_t op = 0; op < 4; ++op)
+            {
+                const auto difference = std::abs(state.phases[op] - stateB.phases[op]);
+                phaseDifference = juce::jmax(phaseDifference, juce::jmin(difference, 1.0f - difference));
+            }
+
+            return juce::jmax(maxDifference(out.first(), out.second(), length), phaseDifference);
+            } });
+
+        return checks;
+    }
+}
+
+int SynthTools::runKernelTests()
+{
+    const auto available = DspKernels::getAvailable();
+    const auto& reference = *DspKernelVariants::getScalar();
+    const auto checks = makeChecks();
+    int numFailed = 0;
+
+    for (const auto* kernels : available)
+    {
+        if (kernels == &reference)
+            continue;
+
+        for (const auto& check : checks)
+        {
+            juce::Random random(42);
+            float worst = 0.0f;
+
+            // Varias rondas por longitud para cubrir fases e incrementos distintos
+            for (auto length : testLengths)
+                for (int round = 0; round < 8; ++round)
+                    worst = juce::jmax(worst, check.run(reference, *kernels, length, random));
+
+            const bool passed = worst <= check.tolerance;
+            numFailed += passed ? 0 : 1;
+
+            std::cout << (passed ? "OK    " : "FALLO ") << juce::String(kernels->name).paddedRight(' ', 8)
+                      << juce::String(check.kernel).paddedRight(' ', 22)
+                      << " diferencia maxima " << juce::String(worst, 9)
+                      << " (tolerancia " << juce::String(check.tolerance, 9) << ")" << std::endl;
+        }
+    }
+
+    if (available.size() < 2)
+        std::cout << "Esta CPU solo tiene la variante escalar: no hay nada que comparar" << std::endl;
+
+    std::cout << (numFailed == 0 ? "Todas las variantes coinciden con la escalar" : juce::String(numFailed) + " comprobaciones fuera de tolerancia")
+              << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}
+
+int SynthTools::runKernelBenchmark(const juce::ArgumentList& args)
+{
+    const int blockSize = args.containsOption("--block") ? juce::jmax(1, args.getValueForOption("--block").getIntValue()) : 256;
+    const int iterations = args.containsOption("--iterations") ? juce::jmax(1, args.getValueForOption("--iterations").getIntValue()) : 20000;
+
+    const auto& data = getTestData();
+    juce::Random random(7);
+    Buffers out(blockSize), source(blockSize), delays(blockSize);
+    fillRandom(random, out.first(), blockSize);
+
+    // Alrededor de 1: multiplicar una y otra vez no lleva a denormales
+    for (int i = 0; i < blockSize; ++i)
+        source.first()[i] = 1.0f + 0.001f * (random.nextFloat() - 0.5f);
+    for (int i = 0; i < blockSize; ++i)
+        delays.first()[i] = (float)(blockSize + 100) + 0.37f * (float)i;
+
+    // Un cuerpo por kernel; los resultados se acumulan para que el compilador no los quite
+    using Body = std::function<void(const DspKernels&)>;
+    float phase = 0.0f;
+    const std::pair<const char*, Body> bodies[] = {
+        { "renderWavetable", [&](const DspKernels& k) { k.renderWavetable(out.first(), blockSize, data.table.data(), tableSize, phase, 11.3f); } },
+        { "renderWavetableMorph", [&](const DspKernels& k) {
+            const auto morphPhase = phase / (float)tableSize;
+            auto p = morphPhase;
+            k.renderWavetableMorph(out.first(), blockSize, data.levels.data(), frameSize, numFrames, 0.3f, p, 0.0051f, 1.5f, 0.001f);
+            phase = p * (float)tableSize;
+            } },
+        { "multiply", [&](const DspKernels& k) { k.multiply(out.first(), source.first(), blockSize); } },
+        { "applyGainRamp", [&](const DspKernels& k) { k.applyGainRamp(out.first(), blockSize, 0.999f, 1.001f); } },
+        { "addWithGain", [&](const DspKernels& k) { k.addWithGain(out.first(), source.first(), blockSize, 0.5f); } },
+        { "readDelayStereo", [&](const DspKernels& k) {
+            k.readDelayStereo(out.first(), source.first(), data.frames.data(), delayMask, 100, delays.first(), blockSize);
+            } },
+        { "renderFm", [&](const DspKernels& k) {
+            DspKernels::FmState fm;
+            fm.ratios = { 1.0f, 2.0f, 3.0f, 0.5f };
+            fm.levels = { 1.0f, 0.7f, 0.5f, 0.3f };
+            fm.carrierGains = { 1.0f, 0.0f, 0.0f, 0.0f };
+            fm.envelopeValues = { 1.0f, 1.0f, 1.0f, 1.0f };
+            fm.modulators[3][2] = fm.modulators[2][1] = fm.modulators[1][0] = 1.0f;
+            fm.modulators[3][3] = 0.2f;
+            auto cycles = 0.01f;
+            k.renderFm(out.first(), blockSize, fm, cycles, 1.0f);
+            } }
+    };
+
+    std::cout << "Bloque de " << blockSize << " muestras, " << iterations << " iteraciones. ns por muestra (x respecto a Scalar)" << std::endl;
+
+    const auto available = DspKernels::getAvailable();
+    float sink = 0.0f;
+
+    for (const auto& [name, body] : bodies)
+    {
+        std::cout << juce::String(name).paddedRight(' ', 22);
+        double scalarNanos = 0.0;
+
+        for (const auto* kernels : available)
+        {
+            // Calentar caches antes de medir
+            for (int i = 0; i < iterations / 10; ++i)
+                body(*kernels);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            for (int i = 0; i < iterations; ++i)
+                body(*kernels);
+            const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            // Que los valores no se vayan a infinito ni a denormales entre iteraciones
+            sink += out.first()[0];
+            fillRandom(random, out.first(), blockSize);
+
+            const auto nanos = seconds * 1.0e9 / ((double)iterations * (double)blockSize);
+            if (kernels->isa == DspKernels::Isa::Scalar)
+                scalarNanos = nanos;
+
+            std::cout << "  " << kernels->name << " " << juce::String(nanos, 3)
+                      << " (x" << juce::String(scalarNanos > 0.0 ? scalarNanos / nanos : 1.0, 2) << ")";
+        }
+
+        std::cout << std::endl;
+    }
+
+    std::cout << "Variante elegida: " << DspKernels::get().name << (sink == 12345.0f ? " " : "") << std::endl;
+    return 0;
+}
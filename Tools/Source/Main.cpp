@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 20 Oct 2026 9:41:17am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "SynthTools.h"
+
+namespace
+{
+    // Un comando que devuelve distinto de 0 hace que el proceso salga con ese codigo
+    void exitWith(int result)
+    {
+        if (result != 0)
+            juce::ConsoleApplication::fail({}, result);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Los procesadores necesitan el MessageManager aunque no haya ventanas
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "SynthTools: pruebas y medidas del motor fuera del plugin", true);
+
+    app.addCommand({ "kernels", "kernels",
+                     "Compara cada variante SIMD de DspKernels con la escalar",
+                     "Entradas aleatorias y longitudes que no son multiplo del ancho del vector; sale con 1 si alguna se pasa de tolerancia.",
+                     [](const juce::ArgumentList&) { exitWith(SynthTools::runKernelTests()); } });
+
+    app.addCommand({ "bench-kernels", "bench-kernels [--block=256] [--iterations=20000]",
+                     "Tiempo por muestra de cada kernel en cada juego de instrucciones",
+                     {},
+                     [](const juce::ArgumentList& args) { exitWith(SynthTools::runKernelBenchmark(args)); } });
+
+    app.addCommand({ "golden", "golden [--update] [--dir=<carpeta>]",
+                     "Renderiza los escenarios de GoldenAudio y los compara con las referencias",
+                     "Test nulo y diferencia espectral frente a GoldenReferences/<escenario>.wav; sale con 1 si alguno falla o falta. "
+                     "Con --update reescribe las referencias con el render actual.",
+                     [](const juce::ArgumentList& args) { exitWith(SynthTools::runGoldenAudio(args)); } });
+
+    app.addCommand({ "replay", "replay <captura.scap> [--output=<salida.wav>]",
+                     "Reproduce una captura del boton Capturar del editor",
+                     "Mismos bloques, MIDI, posicion del host y cambios de estado que en la sesion. Informa de los bloques lentos "
+                     "y del primero cuya salida no coincide; sale con 1 si la salida se separa de la capturada.",
+                     [](const juce::ArgumentList& args) { exitWith(SynthTools::runSessionReplay(args)); } });
+
+    app.addCommand({ "stress", "stress [--instances=8] [--threads=4] [--block=256] [--seconds=10] [--fixed] [--scaling=1,2,4,8]",
+                     "Carga con muchas instancias a la vez y como escala con su numero",
+                     "Rendimiento total, percentiles de cada processBlock y de cada ronda, y memoria por instancia. "
+                     "--fixed deja cada instancia siempre en el mismo hilo.",
+                     [](const juce::ArgumentList& args) { exitWith(SynthTools::runStress(args)); } });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    SessionReplay.cpp
+    Created: 20 Oct 2026 11:20:08am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "SynthTools.h"
+#include "../../Source/SessionCapture.h"
+
+int SynthTools::runSessionReplay(const juce::ArgumentList& args)
+{
+    if (args.size() < 2)
+        juce::ConsoleApplication::fail("Falta el fichero de captura");
+
+    const auto file = args[1].resolveAsExistingFile();
+    const auto output = args.containsOption("--output") ? args.getFileForOption("--output") : juce::File();
+
+    SessionCapture::Session session;
+    juce::String error;
+
+    if (! SessionCapture::load(file, session, error))
+        juce::ConsoleApplication::fail(file.getFullPathName() + ": " + error);
+
+    std::cout << "Reproduciendo " << file.getFullPathName() << std::endl;
+
+    const auto result = SessionCapture::replay(session, output);
+    std::cout << SessionCapture::formatReport(result) << std::endl;
+
+    if (output != juce::File())
+        std::cout << "Salida en " << output.getFullPathName() << std::endl;
+
+    return result.firstMismatchBlock < 0 ? 0 : 1;
+}
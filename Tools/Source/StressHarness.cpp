@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+    StressHarness.cpp
+    Created: 20 Oct 2026 12:12:40am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "StressHarness.h"
+
+#if JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+ #include <psapi.h>
+ #pragma comment(lib, "psapi.lib")
+#elif JUCE_MAC
+ #include <mach/mach.h>
+#elif JUCE_LINUX
+ #include <unistd.h>
+#endif
+
+namespace
+{
+    struct Instance
+    {
+        std::unique_ptr<SynthAudioProcessor> processor;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+        juce::MidiBuffer blockMidi;
+    };
+
+    class Worker : public juce::Thread {
+
+    public:
+        explicit Worker(std::function<void()> jobToRun)
+            : juce::Thread("Stress worker"), job(std::move(jobToRun)) {}
+
+        void run() override { job(); }
+
+    private:
+        std::function<void()> job;
+
+    };
+
+    // Percentil de valores ya ordenados
+    double percentile(const std::vector<double>& sorted, double fraction)
+    {
+        if (sorted.empty())
+            return 0.0;
+
+        return sorted[(size_t)juce::jlimit(0, (int)sorted.size() - 1, (int)(fraction * (double)(sorted.size() - 1) + 0.5))];
+    }
+}
+
+juce::MidiBuffer StressHarness::makeMidi(const Config& config, int instance, int numSamples)
+{
+    // Cada instancia con su propia frase: acordes y notas sueltas de duracion variable
+    juce::Random random(0x5eed + instance * 7919);
+    juce::MidiBuffer midi;
+    const auto meanGap = config.sampleRate / juce::jmax(0.1, config.notesPerSecond);
+
+    for (double position = random.nextDouble() * meanGap; position < (double)numSamples;
+         position += meanGap * (0.5 + random.nextDouble()))
+    {
+        const auto start = (int)position;
+        const auto end = juce::jmin(numSamples - 1, start + (int)(config.sampleRate * (0.1 + 0.7 * random.nextDouble())));
+        const auto velocity = (juce::uint8)(60 + random.nextInt(61));
+
+        auto addNote = [&midi, start, end, velocity](int note) {
+            midi.addEvent(juce::MidiMessage::noteOn(1, note, velocity), start);
+            midi.addEvent(juce::MidiMessage::noteOff(1, note), end);
+            };
+
+        if (random.nextBool())
+        {
+            const int root = 48 + random.nextInt(13);
+            for (auto interval : { 0, 4, 7 })
+                addNote(root + interval);
+        }
+        else
+        {
+            addNote(60 + random.nextInt(25));
+        }
+    }
+
+    return midi;
+}
+
+size_t StressHarness::getResidentBytes()
+{
+#if JUCE_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return (size_t)counters.WorkingSetSize;
+#elif JUCE_MAC
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
+        return (size_t)info.resident_size;
+#elif JUCE_LINUX
+    // Segundo campo de statm: paginas residentes
+    const auto fields = juce::StringArray::fromTokens(juce::File("/proc/self/statm").loadFileAsString(), false);
+    if (fields.size() > 1)
+        return (size_t)fields[1].getLargeIntValue() * (size_t)sysconf(_SC_PAGESIZE);
+#endif
+    return 0;
+}
+
+StressHarness::Result StressHarness::run(const Config& config)
+{
+    Result result;
+    result.config = config;
+
+    const int numInstances = juce::jmax(1, config.numInstances);
+    const int numThreads = juce::jlimit(1, numInstances, config.numThreads);
+    const int numRounds = juce::jmax(1, (int)(config.seconds * config.sampleRate / (double)config.blockSize));
+    const int warmupRounds = juce::jmin(numRounds - 1, (int)(config.warmupSeconds * config.sampleRate / (double)config.blockSize));
+
+    // Todas las reservas antes de medir
+    const auto residentBefore = getResidentBytes();
+    std::vector<std::unique_ptr<Instance>> instances;
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        auto instance = std::make_unique<Instance>();
+        instance->processor = std::make_unique<SynthAudioProcessor>();
+
+        // Instancias distintas entre si, como en una sesion real
+        auto& processor = *instance->processor;
+        processor.setNoiseSeed((juce::uint32)i + 1);
+        // Con el gobernador cada instancia bajaria de calidad segun su carga y
+        // las medidas no serian comparables entre configuraciones
+        processor.setQualityGovernorEnabled(false);
+        processor.setCurrentWaveform(i % (SynthVoice::NoiseBrown + 1));
+        processor.setReverbEnabled(i % 2 == 0);
+        for (int stage = 0; stage < MasterEffectChain::numStages; ++stage)
+            processor.getEffects().setStageEnabled(stage, (i + stage) % 3 == 0);
+
+        processor.setRateAndBufferSizeDetails(config.sampleRate, config.blockSize);
+        processor.prepareToPlay(config.sampleRate, config.blockSize);
+
+        instance->buffer.setSize(processor.getTotalNumOutputChannels(), config.blockSize);
+        instance->midi = makeMidi(config, i, numRounds * config.blockSize);
+        instance->blockMidi.ensureSize(4096);
+        instances.push_back(std::move(instance));
+    }
+
+    const auto residentAfter = getResidentBytes();
+    result.arenaBytesPerInstance = instances.front()->processor->getArenaBytes();
+    result.residentBytesPerInstance = residentAfter > residentBefore ? (residentAfter - residentBefore) / (size_t)numInstances : 0;
+
+    // Una ronda por bloque; el ultimo hilo en llegar cierra la ronda y abre la siguiente
+    std::atomic<int> nextInstance{ 0 };
+    std::atomic<int> arrived{ 0 };
+    std::atomic<int> completedRounds{ 0 };
+    juce::int64 roundStartTicks = 0;
+    std::vector<double> roundMicros((size_t)numRounds, 0.0);
+    std::vector<std::vector<double>> callMicros((size_t)numThreads);
+
+    auto processInstance = [&](int index, int round, std::vector<double>& latencies) {
+        auto& instance = *instances[(size_t)index];
+        const int start = round * config.blockSize;
+
+        instance.buffer.clear();
+        instance.blockMidi.clear();
+        instance.blockMidi.addEvents(instance.midi, start, config.blockSize, -start);
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        instance.processor->processBlock(instance.buffer, instance.blockMidi);
+        const auto micros = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1.0e6;
+
+        if (round >= warmupRounds)
+            latencies.push_back(micros);
+        };
+
+    juce::OwnedArray<Worker> workers;
+
+    for (int thread = 0; thread < numThreads; ++thread)
+    {
+        auto& latencies = callMicros[(size_t)thread];
+        latencies.reserve((size_t)(numRounds - warmupRounds) * (size_t)(config.fixedAssignment ? (numInstances + numThreads - 1) / numThreads : numInstances));
+
+        workers.add(new Worker([&, thread] {
+            auto& ownLatencies = callMicros[(size_t)thread];
+
+            for (int round = 0; round < numRounds; ++round)
+            {
+                if (config.fixedAssignment)
+                {
+                    for (int index = thread; index < numInstances; index += numThreads)
+                        processInstance(index, round, ownLatencies);
+                }
+                else
+                {
+                    for (int index = nextInstance.fetch_add(1); index < numInstances; index = nextInstance.fetch_add(1))
+                        processInstance(index, round, ownLatencies);
+                }
+
+                if (arrived.fetch_add(1) == numThreads - 1)
+                {
+                    const auto now = juce::Time::getHighResolutionTicks();
+                    roundMicros[(size_t)round] = juce::Time::highResolutionTicksToSeconds(now - roundStartTicks) * 1.0e6;
+                    roundStartTicks = now;
+                    arrived = 0;
+                    nextInstance = 0;
+                    completedRounds.store(round + 1, std::memory_order_release);
+                }
+                else
+                {
+                    while (completedRounds.load(std::memory_order_acquire) <= round)
+                        std::this_thread::yield();
+                }
+            }
+            }));
+    }
+
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    roundStartTicks = startTicks;
+
+    for (auto* worker : workers)
+        worker->startThread(juce::Thread::Priority::highest);
+    for (auto* worker : workers)
+        worker->waitForThreadToExit(-1);
+
+    result.wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    result.realtimeFactor = result.wallSeconds > 0.0
+        ? (double)numInstances * (double)numRounds * (double)config.blockSize / config.sampleRate / result.wallSeconds : 0.0;
+
+    std::vector<double> calls;
+    for (const auto& latencies : callMicros)
+        calls.insert(calls.end(), latencies.begin(), latencies.end());
+    std::sort(calls.begin(), calls.end());
+
+    result.callP50 = percentile(calls, 0.5);
+    result.callP99 = percentile(calls, 0.99);
+    result.callP999 = percentile(calls, 0.999);
+    result.callMax = calls.empty() ? 0.0 : calls.back();
+
+    std::vector<double> rounds(roundMicros.begin() + warmupRounds, roundMicros.end());
+    const auto blockMicros = (double)config.blockSize / config.sampleRate * 1.0e6;
+    result.numRounds = (int)rounds.size();
+    result.roundOverruns = (int)std::count_if(rounds.begin(), rounds.end(), [blockMicros](double micros) { return micros > blockMicros; });
+    std::sort(rounds.begin(), rounds.end());
+
+    result.roundP50 = percentile(rounds, 0.5);
+    result.roundP99 = percentile(rounds, 0.99);
+    result.roundMax = rounds.empty() ? 0.0 : rounds.back();
+
+    for (auto& instance : instances)
+        instance->processor->releaseResources();
+
+    return result;
+}
+
+juce::Array<StressHarness::Result> StressHarness::runScaling(const Config& config, const juce::Array<int>& instanceCounts)
+{
+    juce::Array<Result> results;
+
+    for (auto count : instanceCounts)
+    {
+        auto scaled = config;
+        scaled.numInstances = count;
+        results.add(run(scaled));
+    }
+
+    return results;
+}
+
+juce::String StressHarness::formatReport(const juce::Array<Result>& results)
+{
+    juce::String report;
+
+    // La primera fila es la referencia: lo ideal es que el x tiempo real por instancia no baje
+    const auto baseline = results.isEmpty() ? 0.0 : results.getReference(0).realtimeFactor / (double)juce::jmax(1, results.getReference(0).config.numInstances);
+
+    for (const auto& result : results)
+    {
+        const auto perInstance = result.realtimeFactor / (double)juce::jmax(1, result.config.numInstances);
+
+        report << juce::String(result.config.numInstances) << " instancias / " << juce::String(result.config.numThreads) << " hilos"
+               << (result.config.fixedAssignment ? " (fijas)" : "")
+               << ": x" << juce::String(result.realtimeFactor, 1) << " tiempo real"
+               << " (x" << juce::String(perInstance, 1) << " por instancia"
+               << (baseline > 0.0 ? ", " + juce::String(100.0 * perInstance / baseline, 0) + "%" : juce::String()) << ")" << juce::newLine
+               << "  processBlock us: p50 " << juce::String(result.callP50, 1) << ", p99 " << juce::String(result.callP99, 1)
+               << ", p99.9 " << juce::String(result.callP999, 1) << ", max " << juce::String(result.callMax, 1) << juce::newLine
+               << "  ronda us: p50 " << juce::String(result.roundP50, 1) << ", p99 " << juce::String(result.roundP99, 1)
+               << ", max " << juce::String(result.roundMax, 1)
+               << ", tarde " << juce::String(result.roundOverruns) << "/" << juce::String(result.numRounds) << juce::newLine
+               << "  memoria por instancia: arena " << juce::String((double)result.arenaBytesPerInstance / 1024.0, 0) << " KB"
+               << ", residente " << (result.residentBytesPerInstance > 0 ? juce::String((double)result.residentBytesPerInstance / 1024.0, 0) + " KB" : juce::String("?"))
+               << juce::newLine;
+    }
+
+    return report;
+}
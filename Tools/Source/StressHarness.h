@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+	StressHarness.h
+	Created: 20 Oct 2026 12:12:40am
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+// Prueba de carga con muchas instancias a la vez, como en una sesion grande:
+// N SynthAudioProcessor repartidos entre M hilos, cada uno con su propio MIDI.
+// Cada ronda es una llamada del host: todas las instancias procesan un bloque y
+// los hilos esperan a los demas antes de la siguiente. Se mide el rendimiento
+// total, la cola de latencias de cada processBlock y de cada ronda, y la
+// memoria por instancia. Comparando con 1 instancia y 1 hilo se ven la
+// contencion en estado compartido, el false sharing y la cache que no da abasto.
+class StressHarness {
+
+public:
+	struct Config
+	{
+		int numInstances = 8;
+		int numThreads = 4;
+		double sampleRate = 48000.0;
+		int blockSize = 256;
+		double seconds = 10.0;
+		// Bloques que no cuentan al principio (cache fria, primeras reservas)
+		double warmupSeconds = 0.5;
+		// Cada instancia siempre en el mismo hilo; si no, la coge el primer hilo libre
+		bool fixedAssignment = false;
+		// Acordes y notas sueltas por segundo en cada instancia
+		double notesPerSecond = 6.0;
+	};
+
+	struct Result
+	{
+		Config config;
+		double wallSeconds = 0.0;
+		// Segundos de audio de todas las instancias por segundo de reloj
+		double realtimeFactor = 0.0;
+		// Percentiles de cada llamada a processBlock, en microsegundos
+		double callP50 = 0.0, callP99 = 0.0, callP999 = 0.0, callMax = 0.0;
+		// Percentiles de cada ronda completa
+		double roundP50 = 0.0, roundP99 = 0.0, roundMax = 0.0;
+		// Rondas que tardaron mas que la duracion del bloque
+		int roundOverruns = 0;
+		int numRounds = 0;
+		size_t arenaBytesPerInstance = 0;
+		// Memoria residente del proceso ganada al crear y preparar las instancias; 0 si no se sabe
+		size_t residentBytesPerInstance = 0;
+	};
+
+	static Result run(const Config& config);
+	// Misma configuracion con varios numeros de instancias, para ver como escala
+	static juce::Array<Result> runScaling(const Config& config, const juce::Array<int>& instanceCounts);
+	static juce::String formatReport(const juce::Array<Result>& results);
+
+private:
+	static juce::MidiBuffer makeMidi(const Config& config, int instance, int numSamples);
+	static size_t getResidentBytes();
+
+};
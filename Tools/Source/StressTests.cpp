@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    StressTests.cpp
+    Created: 20 Oct 2026 11:34:51am
+    Author:  jrrro
+
+  ==============================================================================
+*/
+
+#include "SynthTools.h"
+#include "StressHarness.h"
+
+int SynthTools::runStress(const juce::ArgumentList& args)
+{
+    auto intOption = [&args](const juce::String& option, int defaultValue) {
+        return args.containsOption(option) ? juce::jmax(1, args.getValueForOption(option).getIntValue()) : defaultValue;
+        };
+
+    StressHarness::Config config;
+    config.numInstances = intOption("--instances", config.numInstances);
+    config.numThreads = intOption("--threads", config.numThreads);
+    config.blockSize = intOption("--block", config.blockSize);
+    config.seconds = (double)intOption("--seconds", (int)config.seconds);
+    config.fixedAssignment = args.containsOption("--fixed");
+
+    // Por defecto: 1 instancia como referencia y luego potencias de 2 hasta las pedidas
+    juce::Array<int> counts;
+
+    if (args.containsOption("--scaling"))
+    {
+        for (const auto& token : juce::StringArray::fromTokens(args.getValueForOption("--scaling"), ",", {}))
+            counts.add(juce::jmax(1, token.getIntValue()));
+    }
+    else
+    {
+        for (int count = 1; count < config.numInstances; count *= 2)
+            counts.add(count);
+        counts.add(config.numInstances);
+    }
+
+    std::cout << "Bloque de " << config.blockSize << " muestras, " << config.seconds << " s por prueba, "
+              << config.numThreads << " hilos" << std::endl;
+    std::cout << StressHarness::formatReport(StressHarness::runScaling(config, counts)) << std::endl;
+    return 0;
+}
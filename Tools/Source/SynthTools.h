@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+	SynthTools.h
+	Created: 20 Oct 2026 9:41:17am
+	Author:  jrrro
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Comandos de la aplicacion de consola SynthTools (ver Main.cpp). Cada uno
+// devuelve el codigo de salida del proceso: 0 si todo fue bien.
+namespace SynthTools
+{
+	// Todas las variantes de DspKernels disponibles en esta CPU frente a la escalar
+	int runKernelTests();
+	// Tiempo por muestra de cada kernel en cada juego de instrucciones
+	int runKernelBenchmark(const juce::ArgumentList& args);
+	// Renders de referencia (GoldenAudio) frente a los WAV de Tools/GoldenReferences
+	int runGoldenAudio(const juce::ArgumentList& args);
+	// Vuelve a pasar una captura de SessionCapture por processBlock
+	int runSessionReplay(const juce::ArgumentList& args);
+	// Muchas instancias en varios hilos a la vez (StressHarness)
+	int runStress(const juce::ArgumentList& args);
+}